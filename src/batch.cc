@@ -0,0 +1,229 @@
+/* Copyright (c) 2004 - 2025, Robert J. Hansen <rjh@sixdemonbag.org>
+ * and Tristan D. Thiede (address currently unknown).
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose with or without fee is hereby granted, provided
+ * that the above copyright notice and this permission notice appear
+ * in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE. */
+
+// Solves a whole batch of Dumas-format instances at once.
+//
+//   djinni_batch [--threads N] [--seed S] PATH...
+//
+// Each PATH is either a directory, in which case every '.set' file in it is
+// solved, or a manifest listing one Dumas file per line (relative paths are
+// taken relative to the manifest; blank lines and lines starting with '#'
+// are ignored).  The instances are loaded and annealed concurrently on a
+// pool of N threads (one per hardware thread by default), and a line of
+// JSON is written for each, in the order the instances were listed: the
+// annealer's dump() fields plus the instance, its seed, the best tour found
+// and the wall time taken.
+//
+// Instance i is seeded with the i-th output of a SplitMix64 generator seeded
+// with S, so the same list and seed always give the same results however
+// many threads there are.
+
+#include "djinni.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+using std::filesystem::path;
+using edu::uiowa::tippie::djinni::Annealer;
+using edu::uiowa::tippie::djinni::Compression;
+using edu::uiowa::tippie::djinni::SplitMix64;
+using edu::uiowa::tippie::djinni::ThreadPool;
+using edu::uiowa::tippie::djinni::TravelingSalesman;
+using edu::uiowa::tippie::djinni::TravelingSalesmanWorld;
+
+namespace {
+  // Adds the instances named by a directory or manifest to a list.
+  void addInstances(const path &source, vector<path> &instances) {
+    if (std::filesystem::is_directory(source)) {
+      vector<path> found;
+      for (const auto &entry : std::filesystem::directory_iterator(source))
+        if (entry.is_regular_file() && entry.path().extension() == ".set")
+          found.push_back(entry.path());
+      std::ranges::sort(found);
+      instances.insert(instances.end(), found.begin(), found.end());
+      return;
+    }
+    std::ifstream manifest(source);
+    if (!manifest)
+      throw std::runtime_error("couldn't read " + source.string());
+    string line;
+    while (std::getline(manifest, line)) {
+      line.erase(0, line.find_first_not_of(" \t"));
+      line.erase(line.find_last_not_of(" \t\r") + 1);
+      if (line.empty() || line.front() == '#')
+        continue;
+      const path instance(line);
+      instances.push_back(instance.is_absolute() ? instance : source.parent_path() / instance);
+    }
+  }
+
+  // Returns a string as a quoted JSON string.
+  string quoted(const string &text) {
+    string result{"\""};
+    for (const char c : text) {
+      switch (c) {
+        case '"': result += "\\\""; break;
+        case '\\': result += "\\\\"; break;
+        case '\b': result += "\\b"; break;
+        case '\f': result += "\\f"; break;
+        case '\n': result += "\\n"; break;
+        case '\r': result += "\\r"; break;
+        case '\t': result += "\\t"; break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+            result += escape;
+          } else {
+            result += c;
+          }
+      }
+    }
+    return result + "\"";
+  }
+
+  // Returns a number as JSON, which has no infinities or NaNs: those
+  // become null.
+  string number(const double value) {
+    if (!std::isfinite(value))
+      return "null";
+    std::ostringstream out;
+    out << value;
+    return out.str();
+  }
+
+  // Returns squeezed dump() fields with every value operator<< wrote as inf
+  // or nan replaced by null.
+  string finiteFields(const string &fields) {
+    string result;
+    for (std::size_t i = 0; i < fields.size();) {
+      result += fields[i];
+      if (fields[i++] != ':' || i == fields.size() || fields[i] == '{' || fields[i] == '"')
+        continue;
+      const std::size_t end = std::min(fields.find_first_of(",}", i), fields.size());
+      const string value = fields.substr(i, end - i);
+      result += std::isfinite(std::strtod(value.c_str(), nullptr)) ? value : "null";
+      i = end;
+    }
+    return result;
+  }
+
+  // Loads and solves one instance, returning its line of JSON.
+  string solve(const path &instance, const uint64_t seed) {
+    const auto started = std::chrono::steady_clock::now();
+    std::ostringstream line;
+    line << "{\"instance\":" << quoted(instance.string()) << ",\"seed\":" << seed;
+    try {
+      // loadFromDumasFile() gives back an empty world for a file it can't
+      // read, and a tour needs a depot and at least one customer.
+      if (!std::filesystem::is_regular_file(instance) || !std::ifstream(instance))
+        throw std::runtime_error("couldn't read " + instance.string());
+      auto world = std::make_shared<TravelingSalesmanWorld>(
+        TravelingSalesmanWorld::loadFromDumasFile(instance.string()));
+      if (world->data().size() < 2)
+        throw std::runtime_error("no customers in " + instance.string());
+      auto initial_solution = TravelingSalesman(world);
+      auto penalty_function = Compression(0.06, 0.0, 0.9999);
+      auto annealer =
+          Annealer(penalty_function, initial_solution, 0.95, 0.94, 75, 100, 30000);
+      annealer.seed(seed);
+      annealer.setSampleThreads(1);
+      const auto &best = annealer.solve();
+
+      // dump() writes a JSON object over several lines; keep its fields, but
+      // squeeze them onto this one.
+      std::ostringstream dump;
+      dump << annealer;
+      string fields = dump.str();
+      std::erase_if(fields, [](const char c) { return c == ' ' || c == '\t' || c == '\n'; });
+      fields = fields.substr(1, fields.rfind('}') - 1);
+
+      std::ostringstream tour;
+      tour << best;
+      std::istringstream customers(tour.str());
+      line << "," << finiteFields(fields) << ",\"tour\":[";
+      int customer;
+      for (bool first = true; customers >> customer; first = false)
+        line << (first ? "" : ",") << customer;
+      line << "]";
+    } catch (const std::exception &e) {
+      line << ",\"error\":" << quoted(e.what());
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+    line << ",\"wall_seconds\":" << number(elapsed.count()) << "}";
+    return line.str();
+  }
+
+  int usage() {
+    cerr << "Usage: djinni_batch [--threads N] [--seed S] DIRECTORY|MANIFEST..." << endl;
+    return 1;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t threads = 0;
+  uint64_t seed = 0;
+  vector<path> instances;
+  try {
+    for (int i = 1; i < argc; i += 1) {
+      const string arg{argv[i]};
+      if ((arg == "--threads" || arg == "--seed") && i + 1 < argc) {
+        const auto value = std::stoull(argv[++i]);
+        if (arg == "--threads")
+          threads = static_cast<uint32_t>(value);
+        else
+          seed = value;
+      } else if (arg.starts_with("--")) {
+        return usage();
+      } else {
+        addInstances(arg, instances);
+      }
+    }
+  } catch (const std::exception &e) {
+    cerr << "Error: " << e.what() << endl;
+    return 1;
+  }
+  if (instances.empty())
+    return usage();
+
+  ThreadPool pool(threads);
+  SplitMix64 seeds(seed);
+  vector<std::future<string> > results;
+  results.reserve(instances.size());
+  for (const auto &instance : instances)
+    results.push_back(pool.submit([instance, seed = seeds()]() { return solve(instance, seed); }));
+  for (auto &result : results)
+    cout << result.get() << endl;
+  return 0;
+}
@@ -0,0 +1,299 @@
+/* Copyright (c) 2004 - 2025, Robert J. Hansen <rjh@sixdemonbag.org>
+ * and Tristan D. Thiede (address currently unknown).
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose with or without fee is hereby granted, provided
+ * that the above copyright notice and this permission notice appear
+ * in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE. */
+
+// Benchmarks for the parts of Djinni whose speed matters most: loading a
+// world, computing its travel times, generating neighbors, and annealing.
+// Every run is seeded, so two builds given the same arguments do exactly
+// the same work and their timings can be compared directly.
+//
+// A customer count of 0 stands for the bundled Dumas-1.set, a standard
+// instance to compare against from one version to the next.  The others
+// are made up on the spot: customers are scattered over a square, visited
+// in a random order, and given twenty-unit time windows around the times
+// that order reaches them, so every instance has at least one feasible tour.
+
+#include "djinni.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Where Dumas-1.set is; CMake points this at the copy in the source tree.
+#ifndef DJINNI_DUMAS_1
+#define DJINNI_DUMAS_1 "Dumas-1.set"
+#endif
+
+using edu::uiowa::tippie::djinni::Annealer;
+using edu::uiowa::tippie::djinni::BasicTravelingSalesmanWorld;
+using edu::uiowa::tippie::djinni::Compression;
+using edu::uiowa::tippie::djinni::TravelingSalesmanSolution;
+using edu::uiowa::tippie::djinni::TravelingSalesmanWorld;
+
+namespace {
+  typedef TravelingSalesmanSolution<TravelingSalesmanWorld> Solution;
+  typedef TravelingSalesmanWorld::Closure Closure;
+
+  constexpr uint64_t SEED{20040601};
+
+  // The customer count which stands for Dumas-1.set.
+  constexpr uint32_t DUMAS_1{0};
+
+  // Returns a synthetic instance with the given number of customers (the
+  // depot included) as a Dumas-format string.
+  std::string makeDumasInstance(const uint32_t customers) {
+    std::mt19937_64 prng(SEED + customers);
+    const double side = 50.0 * std::sqrt(customers / 100.0);
+    std::uniform_real_distribution<> coordinate(0.0, side);
+    std::uniform_real_distribution<> slip(0.0, 20.0);
+    std::vector<double> x(customers), y(customers), ready(customers), due(customers);
+    for (uint32_t i = 0; i < customers; i += 1) {
+      x[i] = std::floor(coordinate(prng));
+      y[i] = std::floor(coordinate(prng));
+    }
+    std::vector<uint32_t> order(customers);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin() + 1, order.end(), prng);
+    double arrival = 0.0;
+    for (uint32_t i = 1; i < customers; i += 1) {
+      const uint32_t from = order[i - 1], to = order[i];
+      arrival += std::floor(std::hypot(x[from] - x[to], y[from] - y[to]));
+      ready[to] = std::max(0.0, std::floor(arrival - slip(prng)));
+      due[to] = ready[to] + 20.0;
+      arrival = std::max(arrival, ready[to]);
+    }
+    due[0] = arrival + std::floor(std::hypot(x[order.back()] - x[0], y[order.back()] - y[0])) + 1.0;
+
+    std::ostringstream out;
+    out << "\n\n!! synthetic-" << customers << "\n\n\n"
+        << "CUST NO.   XCOORD.   YCOORD.    DEMAND   READY TIME   DUE DATE   SERVICE TIME\n\n\n";
+    // Customer number 999 marks the end of the data, so bigger instances
+    // skip it.
+    char line[128];
+    for (uint32_t i = 0, number = 1; i < customers; i += 1, number += (number == 998) ? 2 : 1) {
+      std::snprintf(line, sizeof(line), "%5u %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+                    number, x[i], y[i], 0.0, ready[i], due[i], 0.0);
+      out << line;
+    }
+    std::snprintf(line, sizeof(line), "%5u %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+                  999u, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+    out << line;
+    return out.str();
+  }
+
+  // Returns the name of a Dumas-format file holding the synthetic instance
+  // with the given number of customers, writing it the first time it's asked
+  // for.
+  const std::string &instanceFile(const uint32_t customers) {
+    static std::map<uint32_t, std::string> files{{DUMAS_1, DJINNI_DUMAS_1}};
+    if (auto found = files.find(customers); found != files.end())
+      return found->second;
+    const auto path = std::filesystem::temp_directory_path() /
+                      ("djinni-benchmark-" + std::to_string(customers) + ".set");
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << makeDumasInstance(customers);
+    return files.emplace(customers, path.string()).first->second;
+  }
+
+  // Returns the world for the synthetic instance with the given number of
+  // customers, loading it the first time it's asked for.
+  std::shared_ptr<TravelingSalesmanWorld> instance(const uint32_t customers) {
+    static std::map<uint32_t, std::shared_ptr<TravelingSalesmanWorld> > worlds;
+    auto &world = worlds[customers];
+    if (!world)
+      world = std::make_shared<TravelingSalesmanWorld>(
+        TravelingSalesmanWorld::loadFromDumasFile(instanceFile(customers)));
+    return world;
+  }
+
+  // Returns the number of customers in an instance, labelling the benchmark
+  // with the instance's name if it's a real one rather than a synthetic one.
+  uint32_t customersIn(benchmark::State &state, const uint32_t customers) {
+    if (DUMAS_1 != customers)
+      return customers;
+    state.SetLabel("Dumas-1.set");
+    return instance(customers)->data().size();
+  }
+
+  // Returns a randomly ordered, fully computed solution to an instance.
+  Solution randomSolution(const uint32_t customers) {
+    std::mt19937_64 prng(SEED);
+    Solution solution(instance(customers));
+    solution.randomize(prng);
+    solution.compute();
+    return solution;
+  }
+
+  // Exposes computeTravelTimes(), which is only meant to be called while
+  // loading, so it can be timed by itself.
+  class ExposedWorld : public TravelingSalesmanWorld {
+  public:
+    explicit ExposedWorld(const TravelingSalesmanWorld &world) : TravelingSalesmanWorld(world) {}
+    using TravelingSalesmanWorld::computeTravelTimes;
+  };
+
+  void BM_LoadFromDumasFile(benchmark::State &state) {
+    const auto customers = static_cast<uint32_t>(state.range(0));
+    const auto closure = state.range(1) ? Closure::Enforce : Closure::AssumeMetric;
+    const auto &filename = instanceFile(customers);
+    const uint32_t count = customersIn(state, customers);
+    for (auto _ : state)
+      benchmark::DoNotOptimize(TravelingSalesmanWorld::loadFromDumasFile(filename, closure));
+    state.SetItemsProcessed(state.iterations() * count);
+  }
+
+  // With enforce set this includes closing the travel times under the
+  // triangle inequality, which is most of the cost of loading a world.
+  void BM_ComputeTravelTimes(benchmark::State &state) {
+    const auto customers = static_cast<uint32_t>(state.range(0));
+    const auto closure = state.range(1) ? Closure::Enforce : Closure::AssumeMetric;
+    ExposedWorld world(TravelingSalesmanWorld::loadFromDumasFile(instanceFile(customers), closure));
+    const uint32_t count = customersIn(state, customers);
+    for (auto _ : state) {
+      world.computeTravelTimes();
+      benchmark::DoNotOptimize(world.travelTimes());
+    }
+    state.SetItemsProcessed(state.iterations() * count * count);
+  }
+
+  // generateNeighbor() both makes a neighbor and calls update() on it, so
+  // this is the throughput of the whole of an Annealer's inner loop save for
+  // the acceptance test.
+  void BM_GenerateNeighbor(benchmark::State &state) {
+    const auto customers = static_cast<uint32_t>(state.range(0));
+    customersIn(state, customers);
+    auto current = randomSolution(customers);
+    auto neighbor = current;
+    std::mt19937_64 prng(SEED);
+    for (auto _ : state) {
+      current.generateNeighbor(neighbor, prng);
+      benchmark::DoNotOptimize(neighbor.getP());
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // The same, for the proposeMove()/evaluateMove() pair Annealers use when
+  // they can.
+  void BM_EvaluateMove(benchmark::State &state) {
+    const auto customers = static_cast<uint32_t>(state.range(0));
+    customersIn(state, customers);
+    const auto current = randomSolution(customers);
+    std::mt19937_64 prng(SEED);
+    for (auto _ : state) {
+      auto move = current.proposeMove(prng);
+      current.evaluateMove(move);
+      benchmark::DoNotOptimize(move.p);
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_Solve(benchmark::State &state) {
+    const auto customers = static_cast<uint32_t>(state.range(0));
+    customersIn(state, customers);
+    Solution initial(instance(customers));
+    auto penalty = Compression(0.06, 0.0, 0.9999);
+    double cost = 0.0, penaltyLeft = 0.0, iterations = 0.0;
+    for (auto _ : state) {
+      auto annealer = Annealer(penalty, initial, 0.95, 0.94, 75, 100, 30000);
+      annealer.seed(SEED);
+      const auto &best = annealer.solve();
+      cost = best.getF();
+      penaltyLeft = best.getP();
+      iterations += annealer.iterations();
+    }
+    state.counters["iterations/s"] = benchmark::Counter(iterations, benchmark::Counter::kIsRate);
+    state.counters["cost"] = cost;
+    state.counters["penalty"] = penaltyLeft;
+  }
+
+  // BM_GenerateNeighbor and BM_Solve again, for a world and solution whose
+  // size is fixed at compile time.  They do the same work as the dynamically
+  // sized versions with the same number of customers.
+  template<uint32_t Customers>
+  void BM_GenerateNeighborFixed(benchmark::State &state) {
+    typedef BasicTravelingSalesmanWorld<double, Customers> World;
+    std::mt19937_64 prng(SEED);
+    TravelingSalesmanSolution current(World::loadFromDumasFile(instanceFile(Customers)));
+    current.randomize(prng);
+    current.compute();
+    auto neighbor = current;
+    prng.seed(SEED);
+    for (auto _ : state) {
+      current.generateNeighbor(neighbor, prng);
+      benchmark::DoNotOptimize(neighbor.getP());
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  template<uint32_t Customers>
+  void BM_SolveFixed(benchmark::State &state) {
+    typedef BasicTravelingSalesmanWorld<double, Customers> World;
+    TravelingSalesmanSolution initial(World::loadFromDumasFile(instanceFile(Customers)));
+    auto penalty = Compression(0.06, 0.0, 0.9999);
+    double cost = 0.0, penaltyLeft = 0.0, iterations = 0.0;
+    for (auto _ : state) {
+      auto annealer = Annealer(penalty, initial, 0.95, 0.94, 75, 100, 30000);
+      annealer.seed(SEED);
+      const auto &best = annealer.solve();
+      cost = best.getF();
+      penaltyLeft = best.getP();
+      iterations += annealer.iterations();
+    }
+    state.counters["iterations/s"] = benchmark::Counter(iterations, benchmark::Counter::kIsRate);
+    state.counters["cost"] = cost;
+    state.counters["penalty"] = penaltyLeft;
+  }
+}
+
+// Closing the travel times under the triangle inequality is cubic, so it's
+// only measured up to 500 customers.
+BENCHMARK(BM_LoadFromDumasFile)
+    ->ArgsProduct({{DUMAS_1, 20, 100, 500, 2000}, {0}})
+    ->ArgsProduct({{DUMAS_1, 20, 100, 500}, {1}})
+    ->ArgNames({"customers", "enforce"})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ComputeTravelTimes)
+    ->ArgsProduct({{DUMAS_1, 20, 100, 500, 2000}, {0}})
+    ->ArgsProduct({{DUMAS_1, 20, 100, 500}, {1}})
+    ->ArgNames({"customers", "enforce"})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GenerateNeighbor)
+    ->Arg(DUMAS_1)->Arg(20)->Arg(100)->Arg(500)->Arg(2000)
+    ->ArgName("customers");
+BENCHMARK(BM_EvaluateMove)
+    ->Arg(DUMAS_1)->Arg(20)->Arg(100)->Arg(500)->Arg(2000)
+    ->ArgName("customers");
+// The two- and three-row instances (a depot and one or two customers) are
+// there to show a tour too short for an Insertion still anneals.
+BENCHMARK(BM_Solve)
+    ->Arg(2)->Arg(3)->Arg(DUMAS_1)->Arg(20)->Arg(100)->Arg(500)->Arg(2000)
+    ->ArgName("customers")
+    ->Iterations(1)
+    ->Unit(benchmark::kSecond);
+BENCHMARK_TEMPLATE(BM_GenerateNeighborFixed, 20);
+BENCHMARK_TEMPLATE(BM_GenerateNeighborFixed, 100);
+BENCHMARK_TEMPLATE(BM_SolveFixed, 20)->Iterations(1)->Unit(benchmark::kSecond);
+BENCHMARK_TEMPLATE(BM_SolveFixed, 100)->Iterations(1)->Unit(benchmark::kSecond);
+
+BENCHMARK_MAIN();
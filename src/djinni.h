@@ -16,5 +16,9 @@
  * PERFORMANCE OF THIS SOFTWARE. */
 
 #include "djinni/annealers.h"
+#include "djinni/drivers.h"
+#include "djinni/mapped.h"
+#include "djinni/parallel.h"
 #include "djinni/penalties.h"
+#include "djinni/random.h"
 #include "djinni/routes.h"
@@ -1,715 +1,2032 @@
-/* Copyright (c) 2004 - 2025, Robert J. Hansen <rjh@sixdemonbag.org>
- * and Tristan D. Thiede (address currently unknown).
- *
- * Permission to use, copy, modify, and/or distribute this software
- * for any purpose with or without fee is hereby granted, provided
- * that the above copyright notice and this permission notice appear
- * in all copies.
- *
- * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
- * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
- * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
- * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
- * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
- * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
- * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
- * PERFORMANCE OF THIS SOFTWARE. */
-
-#ifndef ANNEALERS_H
-#define ANNEALERS_H
-
-#include "penalties.h"
-#include <cmath>
-#include <cstdint>
-#include <iosfwd>
-#include <memory>
-#include <random>
-#include <sstream>
-#include <string>
-
-
-namespace edu::uiowa::tippie::djinni {
-    //! A generic Annealer capable of working with a variety of different problem
-    //! types and penalty generators.
-    /*! There is no deep magic hidden in this class.  You may wish to check the
-       specialization for PenaltyFunc = Compressed, which follows this class
-       declaration.
-
-        @author Hansen, Thiede
-        @since 2.1
-    */
-    template<class PenaltyFunc, class SolutionType>
-    class Annealer {
-    public:
-        /*! A convenience typedef for accessing the ReturnType of a
-        given PenaltyType. */
-        typedef typename PenaltyFunc::ReturnType PenaltyType;
-
-        /*!
-        An Annealer constructor which takes all necessary parameters in
-        one fell swoop.
-
-        @param pfunc The penalty function to be applied to this annealer
-        @param sol A solution, populated randomly, to be applied to this annealer
-        @param multT A value in the range 0.0 - 0.9999 representing the temperature
-        multiplier
-        @param accept A value in the range 0.0 - 0.9999 representing our willingness
-        to accept an inferior solution
-        @param tBI The terminal best iteration
-        @param minIter The minimum number of annealing iterations to apply
-        @param maxIter The maximum number of annealing iterations to apply
-        */
-        Annealer(PenaltyFunc &pfunc, SolutionType &sol, double multT, double accept,
-                 uint32_t tBI, uint32_t minIter, uint32_t maxIter): _best(new SolutionType(sol)),
-                                                                    _current(new SolutionType(*_best)),
-                                                                    _neighbor(new SolutionType(*_best)),
-                                                                    _bestIter(0),
-                                                                    _iterations(0),
-                                                                    _maxIterations(maxIter),
-                                                                    _minIterations(minIter),
-                                                                    _terminalBestIter(tBI),
-                                                                    _multiplierT(multT),
-                                                                    _acceptProb(accept),
-                                                                    _currentT(0),
-                                                                    _pfunc(pfunc),
-                                                                    _lambda(PenaltyFunc::defaultReturnTypeValue) {
-        }
-
-        /*! An Annealer constructor appropriate for use with PenaltyFuncs which have a
-        default constructor.
-
-        @param solution A solution, populated randomly, to be applied to this annealer
-        @param multT A value in the range 0.0 - 0.9999 representing the temperature
-        multiplier
-        @param accept A value in the range 0.0 - 0.9999 representing our willingness
-        to accept an inferior solution
-        @param tBI The terminal best iteration
-        @param minIter The minimum number of annealing iterations to apply
-        @param maxIter The maximum number of annealing iterations to apply
-        */
-
-        Annealer(SolutionType &solution, double multT, double accept, uint32_t tBI,
-                 uint32_t minIter, uint32_t maxIter): _best(new SolutionType(solution)),
-                                                      _current(new SolutionType(*_best)),
-                                                      _neighbor(new SolutionType(*_best)),
-                                                      _bestIter(0),
-                                                      _iterations(0),
-                                                      _maxIterations(maxIter),
-                                                      _minIterations(minIter),
-                                                      _terminalBestIter(tBI),
-                                                      _multiplierT(multT),
-                                                      _acceptProb(accept),
-                                                      _currentT(0),
-                                                      _lambda(PenaltyFunc::defaultReturnValueType) {
-        }
-
-        /*! An Annealer constructor for use when the parameters will be set after
-        initialization.
-
-        @param pfunc The penalty function to be applied to this annealer
-        @param sol A solution, populated randomly, to be applied to this annealer
-        */
-        Annealer(PenaltyFunc &pfunc, SolutionType &sol): _best(new SolutionType(sol)),
-                                                         _current(new SolutionType(*_best)),
-                                                         _neighbor(new SolutionType(*_best)),
-                                                         _bestIter(0),
-                                                         _iterations(0),
-                                                         _maxIterations(0),
-                                                         _minIterations(0),
-                                                         _terminalBestIter(0),
-                                                         _multiplierT(0),
-                                                         _acceptProb(0),
-                                                         _currentT(0),
-                                                         _pfunc(pfunc) {
-        }
-
-        /*! A no-op destructor.
-
-        This destructor is virtualized to allow end users to subclass off this
-        template.  Whether an end user should subclass off this template is a
-        different question. */
-        virtual ~Annealer() = default;
-
-        /*! Returns this Annealer's PenaltyFunc */
-        PenaltyFunc &getPenaltyFunc() { return _pfunc; }
-
-        /*! Returns the best solution found by the annealer. */
-        const SolutionType &best() const { return *_best; }
-
-        /*! Returns the current solution in use by the annealer.
-
-        It is unlikely this method will be of use to end users.  Once you hit
-        the solve() method, you're on an uninterruptible trip to the end.
-        However, in the event you want to subclass and do funky things, you
-        have an accessor. */
-        const SolutionType &current() const { return *_current; }
-
-        /*! For a completely-constructed annealer, initiate the solution process and
-         * do not return until termination. */
-        void solve() {
-            *_current = *_best;
-            _best->setP(1000000);
-            initializeParam();
-            tuneTemperature();
-            _iterations = 0;
-            while ((_iterations <= _minIterations) || (_bestIter < _terminalBestIter)) {
-                ++_iterations;
-                for (uint32_t count = 0; count < _maxIterations; ++count) {
-                    _current->generateNeighbor(*_neighbor);
-                    testNeigh();
-                    if ((_current->getP() < _best->getP()) ||
-                        (_current->getP() == _best->getP() && _current->getF() < _best->getF())) {
-                        (*_best) = (*_current);
-                        _bestIter = 1;
-                    }
-                }
-                ++_bestIter;
-                updateParam();
-            }
-        }
-
-        /*! Return a std::string representation of the best solution found by the
-        annealer.
-
-        @return A std::string representation of the best solution found by the
-        annealer. */
-        [[nodiscard]] std::string solution() const {
-            std::stringstream ss;
-            ss << (*_best);
-            std::string result = ss.str();
-            return result;
-        }
-
-        /*! Sets the parameters of the annealer.
-
-        @param multT A value in the range 0.0 - 0.9999 representing the temperature
-        multiplier
-        @param accept A value in the range 0.0 - 0.9999 representing our willingness
-        to accept an inferior solution
-        @param tBI The terminal best iteration
-        @param minIterations The minimum number of annealing iterations to apply
-        @param maxIterations The maximum number of annealing iterations to apply */
-        void setParameters(double multT, double accept, uint32_t tBI,
-                           uint32_t minIterations, uint32_t maxIterations) {
-            _multiplierT = multT;
-            _acceptProb = accept;
-            _terminalBestIter = tBI;
-            _minIterations = minIterations;
-            _maxIterations = maxIterations;
-        }
-
-        /*! Sets the parameters of this annealer's SolutionType by calling that class'
-        constructor.
-
-        @param foo A char* containing the solution parameters */
-        void setSolutionParameters(const char *foo) {
-            _best = std::make_shared<SolutionType>(foo);
-            _current = std::make_shared<SolutionType>(*_best);
-            _neighbor = std::make_shared<SolutionType>(*_best);
-        }
-
-        /*! Allows for an Annealer object's internal state to be dumped in
-        human-readable format to an output stream.
-
-        Please note that this is not meant to be called directly.  Rather, an
-        operator<< will be set up as a proxy to invoke this method.
-
-        @param os The output stream to dump it to
-        @return The output stream os after the operation completes */
-        std::ostream &dump(std::ostream &os) const {
-            os << "{\n\t\"best_solution\": {\n\t\t\"base_cost\": "
-                    << (_best->getF()) << ",\n\t\t\"penalty\":   "
-                    << (_best->getP()) << "\n\t},\n\t"
-                    << "\"best_iteration\":          " << _bestIter << ",\n\t"
-                    << "\"iterations\":              " << _iterations << ",\n\t"
-                    << "\"count_limit\":             " << _maxIterations << ",\n\t"
-                    << "\"minimum_iterations\":      " << _minIterations << ",\n\t"
-                    << "\"sample_size\":             " << _sampleSize << ",\n\t"
-                    << "\"multiplier\":              " << _multiplierT << ",\n\t"
-                    << "\"acceptance_probability\":  " << _acceptProb << ",\n\t"
-                    << "\"terminal_best_iteration\": " << _terminalBestIter << ",\n\t"
-                    << "\"pressure\":                " << _lambda << "\n}\n";
-            return os;
-        }
-
-        /*! Returns the cost of the best solution found by the annealer.
-
-        @return The cost of the best solution found by the annealer.*/
-        [[nodiscard]] double cost() const { return _best->getF(); }
-
-        /*! Returns the penalty incurred by the best solution found by the annealer.
-
-        @return The penalty incurred by the best solution found by the annealer. */
-        [[nodiscard]] double penalty() const { return _best->getP(); }
-        /*! Returns the number of the iteration on which the best solution was
-        encountered.
-
-        @return The number of the iteration on which the best solution was
-        encountered. */
-        [[nodiscard]] uint32_t bestIter() const { return _bestIter; }
-
-        /*! Returns the current iteration number.
-
-        @return The current iteration number. */
-        [[nodiscard]] uint32_t iterations() const { return _iterations; }
-
-        /*! Returns the maximum number of annealer iterations to run.
-
-        @return The maximum number of annealer iterations to run. */
-        [[nodiscard]] uint32_t maxIterations() const { return _maxIterations; }
-
-        /*! Returns the minimum number of annealer iterations to run.
-
-        @return The minimum number of annealer iterations to run. */
-        [[nodiscard]] uint32_t minIterations() const { return _minIterations; }
-        /*! Returns the temperature multiplier.
-
-        @return The temperature multiplier. */
-        [[nodiscard]] double multiplier() const { return _multiplierT; }
-
-        /*! Returns the probability of accepting an inferior move.
-
-        @return The probability of accepting an inferior move. */
-        [[nodiscard]] double probability() const { return _acceptProb; }
-        /*! Returns the current lambda.
-
-        @return The current lambda. */
-        PenaltyType getLambda() const { return _lambda; }
-
-    protected:
-        /*! Performs housekeeping to make sure our parameters are properly set before
-         * entering annealing runs. */
-        void initializeParam() {
-            double lambda1 = 0, sum = 0;
-            for (uint32_t j = 0; j < _sampleSize - 1; j += 2) {
-                _current->randomize();
-                _current->compute();
-                _current->generateNeighbor(*_neighbor);
-                double u = (_current->getF() + lambda1 * _current->getP()) - (
-                               _neighbor->getF() + lambda1 * _neighbor->getP());
-                sum += u > 0 ? u : (-1 * u);
-            }
-
-            sum /= _sampleSize;
-            _currentT = ((-1 * sum) / log(_acceptProb));
-        }
-
-        /*! Runs some initial annealing iterations in order to set the temperature to
-         * the proper initial value. */
-        void tuneTemperature() {
-            int acceptedWorse, uphill;
-            do {
-                acceptedWorse = uphill = 0;
-                for (uint32_t count = 0; count < _maxIterations; count++) {
-                    _current->generateNeighbor(*_neighbor);
-                    double delta = (_neighbor->getF() + _lambda * _neighbor->getP()) - (
-                                       _current->getF() + _lambda * _current->getP());
-                    if (delta < 0)
-                        _current.swap(_neighbor);
-                    else {
-                        uphill++;
-                        double u = 0 - delta / _currentT;
-                        if (randomReal() < exp(u)) {
-                            _current.swap(_neighbor);
-                            acceptedWorse++;
-                        }
-                    }
-                    if ((_current->getP() < _best->getP()) ||
-                        ((_current->getP() == _best->getP()) && (_current->getF() < _best->getF())))
-                        *_best = *_current;
-                }
-                if ((static_cast<double>(acceptedWorse) / static_cast<double>(uphill)) < _acceptProb)
-                    _currentT = 1.5 * _currentT;
-            } while ((static_cast<double>(acceptedWorse) / static_cast<double>(uphill)) < _acceptProb);
-        }
-
-        /*! Tests a neighbor for superiority or inferiority, and may update our
-         * _current solution based on the result. */
-        void testNeigh() {
-            double delta = (_neighbor->getF() + _lambda * _neighbor->getP()) - (
-                               _current->getF() + _lambda * _current->getP());
-            if (delta < 0)
-                _current.swap(_neighbor);
-            else {
-                double u = 0 - delta / _currentT;
-                if (randomReal() < exp(u))
-                    _current.swap(_neighbor);
-            }
-        }
-
-        /*! Updates the temperature and lambda each iteration. */
-        void updateParam() {
-            _currentT = _multiplierT * _currentT;
-            _lambda = _pfunc(_iterations);
-        }
-
-        std::shared_ptr<SolutionType> _best, _current, _neighbor;
-
-        uint32_t _bestIter, _iterations, _maxIterations{}, _minIterations{},
-                _terminalBestIter;
-        static constexpr int _sampleSize = 10000;
-        double _multiplierT{}, _acceptProb{}, _currentT{};
-        PenaltyFunc _pfunc;
-        PenaltyType _lambda;
-        inline static std::random_device rd{};
-        inline static std::mt19937_64 prng{rd()};
-        inline static std::uniform_real_distribution<> urd{0.0, 1.0};
-        static double randomReal() { return urd(prng); }
-    };
-
-    //! An Annealer specialized for Ohlmann-Thomas compressed annealing.
-    /*! For details on Ohlmann-Thomas annealing, please see:
-     *
-     * https://myweb.uiowa.edu/bthoa/DownloadItems/TSPTWpaper4-05-05.pdf
-
-        @author Hansen, Thiede
-        @since 2.1
-    */
-    template<class SolutionType>
-    class Annealer<Compression, SolutionType> {
-    public:
-        typedef Compression PenaltyFunc;
-        typedef PenaltyFunc::ReturnType PenaltyType;
-
-        /*!
-        An Annealer constructor which takes all necessary parameters in
-        one fell swoop.
-
-        @param pfunc The penalty function to be applied to this annealer
-        @param sol A solution, populated randomly, to be applied to this annealer
-        @param multT A value in the range 0.0 - 0.9999 representing the temperature
-        multiplier
-        @param accept A value in the range 0.0 - 0.9999 representing our willingness
-        to accept an inferior solution
-        @param tBI The terminal best iteration
-        @param minIter The minimum number of annealing iterations to apply
-        @param maxIter The maximum number of annealing iterations to apply
-        */
-        Annealer(const PenaltyFunc &pfunc, SolutionType &sol, double multT, double accept,
-                 uint32_t tBI, uint32_t minIter, uint32_t maxIter): _best(new SolutionType(sol)),
-                                                                    _current(new SolutionType(*_best)),
-                                                                    _neighbor(new SolutionType(*_best)),
-                                                                    _bestIter(0),
-                                                                    _iterations(0),
-                                                                    _maxIterations(maxIter),
-                                                                    _minIterations(minIter),
-                                                                    _terminalBestIter(tBI),
-                                                                    _multiplierT(multT),
-                                                                    _acceptProb(accept),
-                                                                    _currentT(0),
-                                                                    _pfunc(pfunc),
-                                                                    _lambda(0) {
-        }
-
-        /*! An Annealer constructor appropriate for use with PenaltyFuncs which have a
-        default constructor.
-
-        @param solution A solution, populated randomly, to be applied to this annealer
-        @param multT A value in the range 0.0 - 0.9999 representing the temperature
-        multiplier
-        @param accept A value in the range 0.0 - 0.9999 representing our willingness
-        to accept an inferior solution
-        @param tBI The terminal best iteration
-        @param minIter The minimum number of annealing iterations to apply
-        @param maxIter The maximum number of annealing iterations to apply
-        */
-
-        Annealer(SolutionType &solution, double multT, double accept, uint32_t tBI,
-                 uint32_t minIter, uint32_t maxIter): _best(new SolutionType(solution)),
-                                                      _current(new SolutionType(*_best)),
-                                                      _neighbor(new SolutionType(*_best)),
-                                                      _bestIter(0),
-                                                      _iterations(0),
-                                                      _maxIterations(maxIter),
-                                                      _minIterations(minIter),
-                                                      _terminalBestIter(tBI),
-                                                      _multiplierT(multT),
-                                                      _acceptProb(accept),
-                                                      _currentT(0),
-                                                      _lambda(0) {
-        }
-
-        /*! An Annealer constructor for use when the parameters will be set after
-        initialization.
-
-        @param pfunc The penalty function to be applied to this annealer
-        @param sol A solution, populated randomly, to be applied to this annealer
-        */
-        Annealer(const PenaltyFunc &pfunc, SolutionType &sol): _best(new SolutionType(sol)),
-                                                               _current(new SolutionType(*_best)),
-                                                               _neighbor(new SolutionType(*_best)),
-                                                               _bestIter(0),
-                                                               _iterations(0),
-                                                               _maxIterations(0),
-                                                               _minIterations(0),
-                                                               _terminalBestIter(0),
-                                                               _multiplierT(0),
-                                                               _acceptProb(0),
-                                                               _currentT(0),
-                                                               _pfunc(pfunc),
-                                                               _lambda(0) {
-        }
-
-        /*! A no-op destructor.
-
-        This destructor is virtualized to allow end users to subclass off this
-        template.  Whether an end user should subclass off this template is a
-        different question. */
-        virtual ~Annealer() = default;
-
-        /*! Returns this Annealer's PenaltyFunc */
-        PenaltyFunc &getPenaltyFunc() { return _pfunc; }
-
-        /*! Returns the best solution found by the annealer. */
-        const SolutionType &best() const { return *_best; }
-
-        /*! Returns the current solution in use by the annealer.
-
-        It is unlikely this method will be of use to end users.  Once you hit
-        the solve() method, you're on an uninterruptible trip to the end.
-        However, in the event you want to subclass and do funky things, you
-        have an accessor. */
-        const SolutionType &current() const { return *_current; }
-
-        /*! For a completely-constructed annealer, initiate the solution process and
-         * do not return until termination. */
-        void solve() {
-            *_current = *_best;
-            _best->setP(1000000);
-            initializeParam();
-            tuneTemperature();
-            _iterations = 0;
-            while ((_iterations <= _minIterations) || (_bestIter < _terminalBestIter)) {
-                ++_iterations;
-                for (uint32_t count = 0; count < _maxIterations; ++count) {
-                    _current->generateNeighbor(*_neighbor);
-                    testNeigh();
-                    if ((_current->getP() < _best->getP()) ||
-                        (_current->getP() == _best->getP() && _current->getF() < _best->getF())) {
-                        (*_best) = (*_current);
-                        _bestIter = 1;
-                    }
-                }
-                ++_bestIter;
-                updateParam();
-            }
-        }
-
-        /*! Return a std::string representation of the best solution found by the
-        annealer.
-
-        @return A std::string representation of the best solution found by the
-        annealer. */
-        [[nodiscard]] std::string solution() const {
-            std::stringstream ss;
-            ss << (*_best);
-            std::string result = ss.str();
-            return result;
-        }
-
-        /*! Sets the parameters of the annealer.
-
-        @param multT A value in the range 0.0 - 0.9999 representing the temperature
-        multiplier
-        @param accept A value in the range 0.0 - 0.9999 representing our willingness
-        to accept an inferior solution
-        @param tBI The terminal best iteration
-        @param minIterations The minimum number of annealing iterations to apply
-        @param maxIterations The maximum number of annealing iterations to apply */
-        void setParameters(double multT, double accept, uint32_t tBI,
-                           uint32_t minIterations, uint32_t maxIterations) {
-            _multiplierT = multT;
-            _acceptProb = accept;
-            _terminalBestIter = tBI;
-            _minIterations = minIterations;
-            _maxIterations = maxIterations;
-        }
-
-        /*! Sets the parameters of this annealer's SolutionType by calling that class'
-        constructor.
-
-        @param foo A char* containing the solution parameters */
-        void setSolutionParameters(const char *foo) {
-            _best = std::make_shared<SolutionType>(foo);
-            _current = std::make_shared<SolutionType>(*_best);
-            _neighbor = std::make_shared<SolutionType>(*_best);
-        }
-
-        /*! Allows for an Annealer object's internal state to be dumped in
-        human-readable format to an output stream.
-
-        Please note that this is not meant to be called directly.  Rather, an
-        operator<< will be set up as a proxy to invoke this method.
-
-        @param os The output stream to dump it to
-        @return The output stream os after the operation completes */
-        std::ostream &dump(std::ostream &os) const {
-            os << "{\n\t\"best_solution\": {\n\t\t\"base_cost\": "
-                    << (_best->getF()) << ",\n\t\t\"penalty\":   "
-                    << (_best->getP()) << "\n\t},\n\t"
-                    << "\"best_iteration\":          " << _bestIter << ",\n\t"
-                    << "\"iterations\":              " << _iterations << ",\n\t"
-                    << "\"count_limit\":             " << _maxIterations << ",\n\t"
-                    << "\"minimum_iterations\":      " << _minIterations << ",\n\t"
-                    << "\"sample_size\":             " << _sampleSize << ",\n\t"
-                    << "\"multiplier\":              " << _multiplierT << ",\n\t"
-                    << "\"acceptance_probability\":  " << _acceptProb << ",\n\t"
-                    << "\"terminal_best_iteration\": " << _terminalBestIter << ",\n\t"
-                    << "\"pressure\":                " << _lambda << "\n}\n";
-            return os;
-        }
-
-        /*! Returns the cost of the best solution found by the annealer.
-
-        @return The cost of the best solution found by the annealer.*/
-        [[nodiscard]] double cost() const { return _best->getF(); }
-
-        /*! Returns the penalty incurred by the best solution found by the annealer.
-
-        @return The penalty incurred by the best solution found by the annealer. */
-        [[nodiscard]] double penalty() const { return _best->getP(); }
-        /*! Returns the number of the iteration on which the best solution was
-        encountered.
-
-        @return The number of the iteration on which the best solution was
-        encountered. */
-        [[nodiscard]] uint32_t bestIter() const { return _bestIter; }
-
-        /*! Returns the current iteration number.
-
-        @return The current iteration number. */
-        [[nodiscard]] uint32_t iterations() const { return _iterations; }
-
-        /*! Returns the maximum number of annealer iterations to run.
-
-        @return The maximum number of annealer iterations to run. */
-        [[nodiscard]] uint32_t maxIterations() const { return _maxIterations; }
-
-        /*! Returns the minimum number of annealer iterations to run.
-
-        @return The minimum number of annealer iterations to run. */
-        [[nodiscard]] uint32_t minIterations() const { return _minIterations; }
-        /*! Returns the temperature multiplier.
-
-        @return The temperature multiplier. */
-        [[nodiscard]] double multiplier() const { return _multiplierT; }
-
-        /*! Returns the probability of accepting an inferior move.
-
-        @return The probability of accepting an inferior move. */
-        [[nodiscard]] double probability() const { return _acceptProb; }
-        /*! Returns the current lambda.
-
-        @return The current lambda. */
-        [[nodiscard]] PenaltyType getLambda() const { return _lambda; }
-
-    protected:
-        /*! Performs housekeeping to make sure our parameters are properly set before
-         * entering annealing runs. */
-        void initializeParam() {
-            double lambda1 = 0, sum = 0;
-            double lambda0 = 0, cap = 0;
-            double solutionScalePressure = _pfunc.getCapPercentage() / (1 - _pfunc.getCapPercentage());
-            for (uint32_t j = 0; j < _sampleSize - 1; j += 2) {
-                _current->randomize();
-                _current->compute();
-                _current->generateNeighbor(*_neighbor);
-                if (_current->getP() > 0)
-                    lambda0 = (_current->getF() / _current->getP()) * solutionScalePressure;
-                if (lambda0 > cap)
-                    cap = lambda0;
-                if (_neighbor->getP() > 0)
-                    lambda0 = (_neighbor->getF() / _neighbor->getP()) * solutionScalePressure;
-                if (lambda0 > cap)
-                    cap = lambda0;
-                double u = (_current->getF() + lambda1 * _current->getP()) - (
-                               _neighbor->getF() + lambda1 * _neighbor->getP());
-                sum += u > 0 ? u : (-1 * u);
-            }
-
-            _pfunc.setPressureCap(cap);
-            sum /= _sampleSize;
-            _currentT = ((-1 * sum) / log(_acceptProb));
-        }
-
-        /*! Run some initial annealing iterations in order to set the temperature to
-         * the proper initial value. */
-        void tuneTemperature() {
-            int acceptedWorse, uphill;
-            uint32_t iterations = 0;
-            do {
-                ++iterations;
-                acceptedWorse = uphill = 0;
-                for (uint32_t count = 0; count < _maxIterations; count++) {
-                    _current->generateNeighbor(*_neighbor);
-                    double delta = (_neighbor->getF() + _lambda * _neighbor->getP()) - (
-                                       _current->getF() + _lambda * _current->getP());
-                    if (delta < 0)
-                        _current.swap(_neighbor);
-                    else {
-                        uphill++;
-                        double u = 0 - delta / _currentT;
-                        double generated = Annealer<Compression, SolutionType>::randomReal();
-                        if (generated < exp(u)) {
-                            _current.swap(_neighbor);
-                            acceptedWorse++;
-                        }
-                    }
-                    if ((_current->getP() < _best->getP()) ||
-                        ((_current->getP() == _best->getP()) && (_current->getF() < _best->getF())))
-                        *_best = *_current;
-                }
-                if ((static_cast<double>(acceptedWorse) / static_cast<double>(uphill)) < _acceptProb)
-                    _currentT = 1.5 * _currentT;
-            } while ((static_cast<double>(acceptedWorse) / static_cast<double>(uphill)) < _acceptProb);
-        }
-
-        /*! Tests a neighbor for superiority or inferiority, and may update our
-         * _current solution based on the result. */
-        void testNeigh() {
-            double delta = (_neighbor->getF() + _lambda * _neighbor->getP()) - (
-                               _current->getF() + _lambda * _current->getP());
-            if (delta < 0)
-                _current.swap(_neighbor);
-            else {
-                double u = 0 - delta / _currentT;
-                if (randomReal() < exp(u))
-                    _current.swap(_neighbor);
-            }
-        }
-
-        /*! Updates the temperature and lambda each iteration. */
-        void updateParam() {
-            _currentT = _multiplierT * _currentT;
-            _lambda = _pfunc(_iterations);
-        }
-
-        std::shared_ptr<SolutionType> _best, _current, _neighbor;
-
-        uint32_t _bestIter, _iterations, _maxIterations, _minIterations,
-                _terminalBestIter;
-        static constexpr int _sampleSize = 10000;
-        double _multiplierT, _acceptProb, _currentT;
-        PenaltyFunc _pfunc;
-        PenaltyType _lambda;
-        inline static std::random_device rd{};
-        inline static std::mt19937_64 prng{rd()};
-        inline static std::uniform_real_distribution<> urd{0.0, 1.0};
-        static double randomReal() { return urd(prng); }
-    };
-
-    /*! An overridden operator<< which serves as a proxy for an Annealer's dump()
-       method.
-
-        @param os The output stream to write the Annealer to
-        @param engine The Annealer to be written
-        @return The output stream after the Annealer is written */
-    template<class PenaltyFunc, class SolutionType>
-    std::ostream &operator<<(std::ostream &os,
-                             const Annealer<PenaltyFunc, SolutionType> &engine) {
-        return engine.dump(os);
-    }
-}
-
-
-#endif
+/* Copyright (c) 2004 - 2025, Robert J. Hansen <rjh@sixdemonbag.org>
+ * and Tristan D. Thiede (address currently unknown).
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose with or without fee is hereby granted, provided
+ * that the above copyright notice and this permission notice appear
+ * in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE. */
+
+#ifndef ANNEALERS_H
+#define ANNEALERS_H
+
+#include "parallel.h"
+#include "penalties.h"
+#include "random.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <iosfwd>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace edu::uiowa::tippie::djinni {
+    /*! Satisfied by solutions which can price a move before making it, as
+        TravelingSalesmanSolution::proposeMove() and friends do.  Annealers use
+        these when they can, rather than building a whole neighbor for every
+        move they consider.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class SolutionType, class Engine>
+    concept ProposesMoves = requires(SolutionType &sol, typename SolutionType::Move &move, Engine &prng) {
+        { std::as_const(sol).proposeMove(prng) } -> std::same_as<typename SolutionType::Move>;
+        std::as_const(sol).evaluateMove(move);
+        sol.commitMove(std::as_const(move));
+        { move.f } -> std::convertible_to<double>;
+        { move.p } -> std::convertible_to<double>;
+    };
+
+    //! What an Annealer reports to its observer after each iteration.
+
+    /*! The counts cover the moves made during that iteration only.
+
+        @author Hansen
+        @since 2.5
+    */
+    struct AnnealerProgress {
+        uint32_t iteration{0};          //!< The iteration just finished, counting from 1
+        double temperature{0.0};        //!< The temperature it ran at
+        double lambda{0.0};             //!< The penalty multiplier it ran with
+        double currentF{0.0};           //!< The current solution's feasible component
+        double currentP{0.0};           //!< The current solution's penalty component
+        double bestF{0.0};              //!< The best solution's feasible component
+        double bestP{0.0};              //!< The best solution's penalty component
+        uint64_t accepted{0};           //!< Moves made
+        uint64_t rejected{0};           //!< Moves turned down
+        uint64_t uphill{0};             //!< Moves proposed which were no better than the current solution
+    };
+
+    //! What an annealer learns from sampling random solutions before it starts.
+
+    /*! @author Hansen
+        @since 2.5
+    */
+    struct ParameterSample {
+        double spread{0.0}; //!< The sum of |F(solution) - F(neighbor)| over every pair sampled
+        double cap{0.0};    //!< The largest scaled F / P ratio seen, for Compression's pressure cap
+    };
+
+    /*! Draws pairs of a random solution and one of its neighbors, as annealers
+        do to choose their starting temperature and pressure cap, spreading the
+        work over several threads.
+
+        The pairs are dealt out in fixed chunks, each of which gets its own
+        copy of the starting solution and its own generator seeded from a
+        SplitMix64 stream, and the chunks' results are combined in order.  So
+        for a given seed the result is the same however many threads do the
+        work.  Solutions which can't take a generator draw from their own
+        (thread-local) ones, and can't be reproduced this way.
+
+        @param start A solution to copy; only its world is used
+        @param pairs The number of pairs to draw
+        @param scale The factor applied to each F / P ratio; 0 if the cap isn't
+        wanted
+        @param seed The seed from which every chunk's generator is seeded
+        @param threads The most threads to use; 0 means one per hardware thread
+        @return The spread and cap over all the pairs
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class SolutionType, class Engine>
+    ParameterSample sampleParameters(const SolutionType &start, const uint32_t pairs, const double scale,
+                                     const uint64_t seed, const uint32_t threads = 0) {
+        constexpr uint32_t chunkSize = 128;
+        const uint32_t chunks = (pairs + chunkSize - 1) / chunkSize;
+        std::vector<uint64_t> seeds(chunks);
+        SplitMix64 mix(seed);
+        std::ranges::generate(seeds, mix);
+        std::vector<ParameterSample> partial(chunks);
+        parallelFor(0, chunks, [&](const uint32_t chunk) {
+            Engine prng(seeds[chunk]);
+            SolutionType current(start);
+            [[maybe_unused]] SolutionType neighbor(start);
+            ParameterSample &out = partial[chunk];
+            const uint32_t last = std::min(pairs, (chunk + 1) * chunkSize);
+            for (uint32_t pair = chunk * chunkSize; pair < last; pair += 1) {
+                if constexpr (requires { current.randomize(prng); })
+                    current.randomize(prng);
+                else
+                    current.randomize();
+                current.compute();
+                double neighborF, neighborP;
+                if constexpr (ProposesMoves<SolutionType, Engine>) {
+                    auto move = current.proposeMove(prng);
+                    current.evaluateMove(move);
+                    neighborF = move.f;
+                    neighborP = move.p;
+                } else {
+                    if constexpr (requires { current.generateNeighbor(neighbor, prng); })
+                        current.generateNeighbor(neighbor, prng);
+                    else
+                        current.generateNeighbor(neighbor);
+                    neighborF = neighbor.getF();
+                    neighborP = neighbor.getP();
+                }
+                if (current.getP() > 0)
+                    out.cap = std::max(out.cap, (current.getF() / current.getP()) * scale);
+                if (neighborP > 0)
+                    out.cap = std::max(out.cap, (neighborF / neighborP) * scale);
+                out.spread += std::abs(current.getF() - neighborF);
+            }
+        }, threads);
+        ParameterSample total;
+        for (const auto &chunk: partial) {
+            total.spread += chunk.spread;
+            total.cap = std::max(total.cap, chunk.cap);
+        }
+        return total;
+    }
+
+    //! Settings for an Annealer's adaptive temperature schedule.
+
+    /*! Geometric cooling eventually leaves the temperature so low that almost
+        nothing is accepted, and an annealer can spend many iterations there
+        waiting for its terminal best iteration to come round.  An adaptive
+        schedule watches for that.  Once the acceptance rate has stayed at or
+        below frozenAcceptance for window iterations in a row, and the best
+        solution hasn't improved for at least stagnation iterations, the search
+        is frozen: the annealer reheats to reheat times its starting
+        temperature, up to maxReheats times, and after that stops, provided
+        it has run its minimum number of iterations.
+
+        Moves which leave the cost unchanged are always accepted, so the
+        acceptance rate rarely reaches zero; frozenAcceptance should be a
+        little above the rate of those.
+
+        By default a frozen search simply stops, which on Dumas-1.set saves
+        about a quarter of the iterations for the same result; raise
+        maxReheats to give it more chances first.  The default window of zero
+        turns all of this off.
+
+        @author Hansen
+        @since 2.5
+    */
+    struct AdaptiveSchedule {
+        uint32_t window{0};             //!< Frozen iterations in a row before acting; 0 disables
+        double frozenAcceptance{0.002}; //!< The acceptance rate at or below which an iteration is frozen
+        uint32_t stagnation{10};        //!< Iterations without a new best before acting
+        double reheat{0.1};             //!< The fraction of the starting temperature to reheat to
+        uint32_t maxReheats{0};         //!< The most times to reheat
+        bool stopWhenFrozen{true};      //!< Whether to stop once out of reheats
+    };
+
+    //! An Annealer observer which does nothing, and costs nothing.
+
+    /*! An observer is any class with a member function
+        <tt>void operator()(const AnnealerProgress &)</tt>, which an Annealer
+        calls after each iteration.  An observer may also declare
+        <tt>static constexpr bool enabled = false</tt>, as this one does, to
+        tell the Annealer not to bother counting moves or calling it at all.
+
+        @author Hansen
+        @since 2.5
+    */
+    struct NullObserver {
+        static constexpr bool enabled = false;
+
+        void operator()(const AnnealerProgress &) const {}
+    };
+
+    //! An Annealer observer which hands each iteration's progress to a function.
+
+    /*! @author Hansen
+        @since 2.5
+    */
+    struct CallbackObserver {
+        std::function<void(const AnnealerProgress &)> callback;
+
+        void operator()(const AnnealerProgress &progress) const {
+            if (callback)
+                callback(progress);
+        }
+    };
+
+    /*! True unless an observer declares itself disabled.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class Observer>
+    inline constexpr bool observerEnabled = [] {
+        if constexpr (requires { Observer::enabled; })
+            return static_cast<bool>(Observer::enabled);
+        else
+            return true;
+    }();
+
+    //! Counts of what an Annealer has been doing, and where its time went.
+
+    /*! These are only collected if USE_PERFORMANCE_COUNTERS is defined when
+        the library is compiled; otherwise they stay zero, and cost nothing.
+        The timers read std::chrono::steady_clock before and after every call
+        they cover, which adds some tens of nanoseconds per move, so compare
+        instrumented builds with each other rather than with uninstrumented
+        ones.
+
+        For solutions which satisfy ProposesMoves, generating a neighbor is
+        proposeMove(), evaluating it is evaluateMove() (what update() does for
+        generateNeighbor()), and committing it is commitMove() (what
+        timingUpdate() does).  Otherwise generateNeighbor() does all three and
+        its time is counted as generating.
+
+        @author Hansen
+        @since 2.5
+    */
+    struct PerformanceCounters {
+        uint64_t proposals{0};              //!< Neighbors proposed
+        uint64_t acceptances{0};            //!< Neighbors moved to
+        uint64_t uphillAcceptances{0};      //!< Neighbors moved to which were no better
+        uint64_t improvements{0};           //!< Times a new best solution was found
+        uint64_t generateNanoseconds{0};    //!< Time spent generating neighbors
+        uint64_t evaluateNanoseconds{0};    //!< Time spent pricing them
+        uint64_t testNanoseconds{0};        //!< Time spent deciding whether to move
+        uint64_t commitNanoseconds{0};      //!< Time spent moving
+
+        /*! Adds one to a counter, if counters are enabled.
+
+        @param counter The counter */
+        static void tally([[maybe_unused]] uint64_t &counter) {
+#ifdef USE_PERFORMANCE_COUNTERS
+            ++counter;
+#endif
+        }
+
+        /*! Calls a function, adding the time it takes to a counter if counters
+        are enabled.
+
+        @param nanoseconds The counter
+        @param function The function to call
+        @return Whatever the function returns */
+        template<class Function>
+        static decltype(auto) timed([[maybe_unused]] uint64_t &nanoseconds, Function &&function) {
+#ifdef USE_PERFORMANCE_COUNTERS
+            struct Stopwatch {
+                uint64_t &total;
+                std::chrono::steady_clock::time_point started{std::chrono::steady_clock::now()};
+
+                ~Stopwatch() {
+                    total += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - started).count();
+                }
+            } stopwatch{nanoseconds};
+#endif
+            return function();
+        }
+
+        //! Adds another set of counters to these.
+        PerformanceCounters &operator+=(const PerformanceCounters &other) {
+            proposals += other.proposals;
+            acceptances += other.acceptances;
+            uphillAcceptances += other.uphillAcceptances;
+            improvements += other.improvements;
+            generateNanoseconds += other.generateNanoseconds;
+            evaluateNanoseconds += other.evaluateNanoseconds;
+            testNanoseconds += other.testNanoseconds;
+            commitNanoseconds += other.commitNanoseconds;
+            return *this;
+        }
+
+        /*! Writes the counters out as the body of a JSON object.
+
+        @param os The output stream to write to
+        @param indent What to start each line with
+        @return The output stream after we've written to it */
+        std::ostream &dump(std::ostream &os, const char *indent) const {
+            os << indent << "\"proposals\":          " << proposals << ",\n"
+                    << indent << "\"acceptances\":        " << acceptances << ",\n"
+                    << indent << "\"uphill_acceptances\": " << uphillAcceptances << ",\n"
+                    << indent << "\"improvements\":       " << improvements << ",\n"
+                    << indent << "\"generate_ns\":        " << generateNanoseconds << ",\n"
+                    << indent << "\"evaluate_ns\":        " << evaluateNanoseconds << ",\n"
+                    << indent << "\"test_ns\":            " << testNanoseconds << ",\n"
+                    << indent << "\"commit_ns\":          " << commitNanoseconds << "\n";
+            return os;
+        }
+    };
+
+    //! A generic Annealer capable of working with a variety of different problem
+    //! types and penalty generators.
+    /*! There is no deep magic hidden in this class.  You may wish to check the
+       specialization for PenaltyFunc = Compressed, which follows this class
+       declaration.
+
+       If an Observer is given, it's told how each iteration went as soon as
+       the iteration is over; see NullObserver.
+
+        @author Hansen, Thiede
+        @since 2.1
+    */
+    template<class PenaltyFunc, class SolutionType, class Engine = std::mt19937_64,
+        class Observer = NullObserver>
+    class Annealer {
+    public:
+        /*! A convenience typedef for accessing the ReturnType of a
+        given PenaltyType. */
+        typedef typename PenaltyFunc::ReturnType PenaltyType;
+
+        /*!
+        An Annealer constructor which takes all necessary parameters in
+        one fell swoop.
+
+        @param pfunc The penalty function to be applied to this annealer
+        @param sol A solution, populated randomly, to be applied to this annealer
+        @param multT A value in the range 0.0 - 0.9999 representing the temperature
+        multiplier
+        @param accept A value in the range 0.0 - 0.9999 representing our willingness
+        to accept an inferior solution
+        @param tBI The terminal best iteration
+        @param minIter The minimum number of annealing iterations to apply
+        @param maxIter The maximum number of annealing iterations to apply
+        */
+        Annealer(PenaltyFunc &pfunc, SolutionType &sol, double multT, double accept,
+                 uint32_t tBI, uint32_t minIter, uint32_t maxIter): _best(new SolutionType(sol)),
+                                                                    _current(new SolutionType(*_best)),
+                                                                    _neighbor(new SolutionType(*_best)),
+                                                                    _bestIter(0),
+                                                                    _iterations(0),
+                                                                    _maxIterations(maxIter),
+                                                                    _minIterations(minIter),
+                                                                    _terminalBestIter(tBI),
+                                                                    _multiplierT(multT),
+                                                                    _acceptProb(accept),
+                                                                    _currentT(0),
+                                                                    _pfunc(pfunc),
+                                                                    _lambda(PenaltyFunc::defaultReturnTypeValue) {
+        }
+
+        /*! An Annealer constructor appropriate for use with PenaltyFuncs which have a
+        default constructor.
+
+        @param solution A solution, populated randomly, to be applied to this annealer
+        @param multT A value in the range 0.0 - 0.9999 representing the temperature
+        multiplier
+        @param accept A value in the range 0.0 - 0.9999 representing our willingness
+        to accept an inferior solution
+        @param tBI The terminal best iteration
+        @param minIter The minimum number of annealing iterations to apply
+        @param maxIter The maximum number of annealing iterations to apply
+        */
+
+        Annealer(SolutionType &solution, double multT, double accept, uint32_t tBI,
+                 uint32_t minIter, uint32_t maxIter): _best(new SolutionType(solution)),
+                                                      _current(new SolutionType(*_best)),
+                                                      _neighbor(new SolutionType(*_best)),
+                                                      _bestIter(0),
+                                                      _iterations(0),
+                                                      _maxIterations(maxIter),
+                                                      _minIterations(minIter),
+                                                      _terminalBestIter(tBI),
+                                                      _multiplierT(multT),
+                                                      _acceptProb(accept),
+                                                      _currentT(0),
+                                                      _lambda(PenaltyFunc::defaultReturnValueType) {
+        }
+
+        /*! An Annealer constructor for use when the parameters will be set after
+        initialization.
+
+        @param pfunc The penalty function to be applied to this annealer
+        @param sol A solution, populated randomly, to be applied to this annealer
+        */
+        Annealer(PenaltyFunc &pfunc, SolutionType &sol): _best(new SolutionType(sol)),
+                                                         _current(new SolutionType(*_best)),
+                                                         _neighbor(new SolutionType(*_best)),
+                                                         _bestIter(0),
+                                                         _iterations(0),
+                                                         _maxIterations(0),
+                                                         _minIterations(0),
+                                                         _terminalBestIter(0),
+                                                         _multiplierT(0),
+                                                         _acceptProb(0),
+                                                         _currentT(0),
+                                                         _pfunc(pfunc) {
+        }
+
+        /*! A no-op destructor.
+
+        This destructor is virtualized to allow end users to subclass off this
+        template.  Whether an end user should subclass off this template is a
+        different question. */
+        virtual ~Annealer() = default;
+
+        /*! Returns this Annealer's PenaltyFunc */
+        PenaltyFunc &getPenaltyFunc() { return _pfunc; }
+
+        /*! Returns the best solution found by the annealer. */
+        const SolutionType &best() const { return *_best; }
+
+        /*! Returns the current solution in use by the annealer.
+
+        It is unlikely this method will be of use to end users.  Once you hit
+        the solve() method, you're on a trip to the end, or to the deadline or
+        stop request if you've set one.  However, in the event you want to
+        subclass and do funky things, you have an accessor. */
+        const SolutionType &current() const { return *_current; }
+
+        /*! For a completely-constructed annealer, initiate the solution process and
+         * do not return until termination, the deadline, or a stop request.
+
+        @return The best solution found */
+        const SolutionType &solve() {
+            start();
+            while (!finished())
+                step();
+            return *_best;
+        }
+
+        /*! Prepares to anneal: estimates the starting parameters and tunes the
+        temperature.  solve() is just start() followed by step() until
+        finished(); call them yourself if you need to do something between
+        iterations. */
+        void start() {
+            _stopped = false;
+            _currentIsBest = false;
+            *_current = *_best;
+            _best->setP(1000000);
+            initializeParam();
+            tuneTemperature();
+            _iterations = 0;
+            _startT = _currentT;
+            _frozenIterations = _reheats = 0;
+            _frozen = false;
+            _counters = {};
+        }
+
+        /*! Runs one annealing iteration: _maxIterations moves at the current
+        temperature, followed by a parameter update. */
+        void step() {
+            if (stopRequested()) {
+                halt();
+                return;
+            }
+            ++_iterations;
+            uint64_t accepted = 0;
+            [[maybe_unused]] uint64_t uphillMoves = 0;
+            for (uint32_t count = 0, check = _checkInterval; count < _maxIterations; ++count) {
+                bool uphill;
+                accepted += tryMove(uphill);
+                if constexpr (observerEnabled<Observer>)
+                    uphillMoves += uphill;
+                if (improvesOnBest())
+                    _bestIter = 1;
+                if (0 == --check) {
+                    if (stopRequested()) {
+                        halt();
+                        return;
+                    }
+                    check = _checkInterval;
+                }
+            }
+            syncBest();
+            if constexpr (observerEnabled<Observer>)
+                _observer(AnnealerProgress{
+                    _iterations, _currentT, static_cast<double>(_lambda), _current->getF(), _current->getP(),
+                    _best->getF(), _best->getP(), accepted, _maxIterations - accepted, uphillMoves
+                });
+            ++_bestIter;
+            updateParam();
+            adaptSchedule(accepted);
+        }
+
+        /*! Returns true once the termination criteria have been met, or once
+        we've stopped early. */
+        [[nodiscard]] bool finished() const {
+            return _stopped || _frozen ||
+                   !((_iterations <= _minIterations) || (_bestIter < _terminalBestIter));
+        }
+
+        /*! Sets up an adaptive temperature schedule.  It takes effect from the
+        next start() or solve().
+
+        @param schedule The schedule's settings
+        @throw std::invalid_argument if frozenAcceptance isn't in [0, 1) or
+        reheat isn't positive */
+        void setSchedule(const AdaptiveSchedule &schedule) {
+            if (!(schedule.frozenAcceptance >= 0.0 && schedule.frozenAcceptance < 1.0))
+                throw std::invalid_argument("frozen acceptance rate must be in [0, 1)");
+            if (!(schedule.reheat > 0.0))
+                throw std::invalid_argument("reheat fraction must be positive");
+            _schedule = schedule;
+        }
+
+        /*! Returns the adaptive temperature schedule's settings. */
+        [[nodiscard]] const AdaptiveSchedule &schedule() const { return _schedule; }
+
+        /*! Returns the number of times the last run reheated. */
+        [[nodiscard]] uint32_t reheats() const { return _reheats; }
+
+        /*! Returns true if the last run stopped because its search froze. */
+        [[nodiscard]] bool frozen() const { return _frozen; }
+
+        /*! Sets a time by which annealing must stop.  It's checked before each
+        iteration and every few moves within one (see setCheckInterval()); on
+        reaching it, the annealer stops with the best solution found so far.
+
+        @param deadline The time to stop by */
+        void setDeadline(const std::chrono::steady_clock::time_point deadline) { _deadline = deadline; }
+
+        /*! Sets a stop token which, once a stop is requested through it, makes
+        the annealer stop as it would at a deadline.  It's safe to request the
+        stop from another thread.
+
+        @param token The stop token to watch */
+        void setStopToken(std::stop_token token) { _stopToken = std::move(token); }
+
+        /*! Sets how many moves are made between checks of the deadline and stop
+        token within an iteration.  The default, 1024, costs nothing noticeable
+        and reacts within well under a millisecond on typical problems.
+
+        @param moves The number of moves between checks */
+        void setCheckInterval(const uint32_t moves) { _checkInterval = std::max<uint32_t>(1, moves); }
+
+        /*! Sets how many random solutions and neighbors are sampled to choose
+        the starting temperature.  Fewer samples make for a quicker start
+        and a rougher estimate.
+
+        @param samples The number of solutions and neighbors, counted together,
+        as the default of 10,000 is
+        @throw std::invalid_argument if samples is less than 2 */
+        void setSampleSize(const uint32_t samples) {
+            if (samples < 2)
+                throw std::invalid_argument("sample size must be at least 2");
+            _sampleSize = samples;
+        }
+
+        /*! Returns the number of random solutions and neighbors sampled. */
+        [[nodiscard]] uint32_t sampleSize() const { return _sampleSize; }
+
+        /*! Sets the most threads sampling may use.  The default, 0, means one
+        per hardware thread; when many annealers are running at once, 1 is
+        better.  The result doesn't depend on it.
+
+        @param threads The most threads to use */
+        void setSampleThreads(const uint32_t threads) { _sampleThreads = threads; }
+
+        /*! Returns true if the last run was cut short by the deadline or a stop
+        request. */
+        [[nodiscard]] bool stopped() const { return _stopped; }
+
+        /*! Replaces this annealer's observer.
+
+        @param observer The observer to call after each iteration */
+        void setObserver(Observer observer) { _observer = std::move(observer); }
+
+        /*! Returns this annealer's observer. */
+        Observer &observer() { return _observer; }
+
+        /*! Replaces the current solution, leaving the temperature, lambda and
+        best solution alone.  Annealing carries on from the new solution at the
+        next step().
+
+        @param sol The solution to carry on from */
+        void restartFrom(const SolutionType &sol) {
+            syncBest();
+            *_current = sol;
+        }
+
+        /*! Return a std::string representation of the best solution found by the
+        annealer.
+
+        @return A std::string representation of the best solution found by the
+        annealer. */
+        [[nodiscard]] std::string solution() const {
+            std::stringstream ss;
+            ss << (*_best);
+            std::string result = ss.str();
+            return result;
+        }
+
+        /*! Sets the parameters of the annealer.
+
+        @param multT A value in the range 0.0 - 0.9999 representing the temperature
+        multiplier
+        @param accept A value in the range 0.0 - 0.9999 representing our willingness
+        to accept an inferior solution
+        @param tBI The terminal best iteration
+        @param minIterations The minimum number of annealing iterations to apply
+        @param maxIterations The maximum number of annealing iterations to apply */
+        void setParameters(double multT, double accept, uint32_t tBI,
+                           uint32_t minIterations, uint32_t maxIterations) {
+            _multiplierT = multT;
+            _acceptProb = accept;
+            _terminalBestIter = tBI;
+            _minIterations = minIterations;
+            _maxIterations = maxIterations;
+        }
+
+        /*! Sets the parameters of this annealer's SolutionType by calling that class'
+        constructor.
+
+        @param foo A char* containing the solution parameters */
+        void setSolutionParameters(const char *foo) {
+            _best = std::make_shared<SolutionType>(foo);
+            _current = std::make_shared<SolutionType>(*_best);
+            _neighbor = std::make_shared<SolutionType>(*_best);
+        }
+
+        /*! Allows for an Annealer object's internal state to be dumped in
+        human-readable format to an output stream.
+
+        Please note that this is not meant to be called directly.  Rather, an
+        operator<< will be set up as a proxy to invoke this method.
+
+        @param os The output stream to dump it to
+        @return The output stream os after the operation completes */
+        std::ostream &dump(std::ostream &os) const {
+            os << "{\n\t\"best_solution\": {\n\t\t\"base_cost\": "
+                    << (_best->getF()) << ",\n\t\t\"penalty\":   "
+                    << (_best->getP()) << "\n\t},\n\t"
+                    << "\"best_iteration\":          " << _bestIter << ",\n\t"
+                    << "\"iterations\":              " << _iterations << ",\n\t"
+                    << "\"count_limit\":             " << _maxIterations << ",\n\t"
+                    << "\"minimum_iterations\":      " << _minIterations << ",\n\t"
+                    << "\"sample_size\":             " << _sampleSize << ",\n\t"
+                    << "\"multiplier\":              " << _multiplierT << ",\n\t"
+                    << "\"acceptance_probability\":  " << _acceptProb << ",\n\t"
+                    << "\"terminal_best_iteration\": " << _terminalBestIter << ",\n\t"
+                    << "\"pressure\":                " << _lambda;
+#ifdef USE_PERFORMANCE_COUNTERS
+            os << ",\n\t\"performance_counters\": {\n";
+            _counters.dump(os, "\t\t") << "\t}";
+#endif
+            os << "\n}\n";
+            return os;
+        }
+
+        /*! Returns what this annealer has been doing and where its time went.
+        Everything stays zero unless USE_PERFORMANCE_COUNTERS is defined. */
+        [[nodiscard]] const PerformanceCounters &counters() const { return _counters; }
+
+        /*! Returns the cost of the best solution found by the annealer.
+
+        @return The cost of the best solution found by the annealer.*/
+        [[nodiscard]] double cost() const { return _best->getF(); }
+
+        /*! Returns the penalty incurred by the best solution found by the annealer.
+
+        @return The penalty incurred by the best solution found by the annealer. */
+        [[nodiscard]] double penalty() const { return _best->getP(); }
+        /*! Returns the number of the iteration on which the best solution was
+        encountered.
+
+        @return The number of the iteration on which the best solution was
+        encountered. */
+        [[nodiscard]] uint32_t bestIter() const { return _bestIter; }
+
+        /*! Returns the current iteration number.
+
+        @return The current iteration number. */
+        [[nodiscard]] uint32_t iterations() const { return _iterations; }
+
+        /*! Returns the maximum number of annealer iterations to run.
+
+        @return The maximum number of annealer iterations to run. */
+        [[nodiscard]] uint32_t maxIterations() const { return _maxIterations; }
+
+        /*! Returns the minimum number of annealer iterations to run.
+
+        @return The minimum number of annealer iterations to run. */
+        [[nodiscard]] uint32_t minIterations() const { return _minIterations; }
+        /*! Returns the temperature multiplier.
+
+        @return The temperature multiplier. */
+        [[nodiscard]] double multiplier() const { return _multiplierT; }
+
+        /*! Returns the probability of accepting an inferior move.
+
+        @return The probability of accepting an inferior move. */
+        [[nodiscard]] double probability() const { return _acceptProb; }
+        /*! Reseeds this annealer's random number generator.  Two annealers
+        built from the same solution, given the same parameters and seed, will
+        follow exactly the same path.
+
+        @param seed The new seed */
+        void seed(const uint64_t seed) {
+            _prng.seed(seed);
+            _exponentials.reset();
+        }
+
+        /*! Returns this annealer's random number generator.
+
+        @return This annealer's random number generator. */
+        Engine &engine() { return _prng; }
+
+        /*! Returns the current lambda.
+
+        @return The current lambda. */
+        PenaltyType getLambda() const { return _lambda; }
+
+    protected:
+        /*! Performs housekeeping to make sure our parameters are properly set before
+         * entering annealing runs. */
+        void initializeParam() {
+            const auto sample = sampleParameters<SolutionType, Engine>(*_current, _sampleSize / 2, 0.0, _prng(),
+                                                                       _sampleThreads);
+            _currentT = ((-1 * sample.spread / _sampleSize) / log(_acceptProb));
+            // No sampled move changed F (every way round a tour of one or two
+            // customers costs the same), and tuneTemperature() can't raise a
+            // temperature of zero; start it from one instead.
+            if (0.0 == sample.spread)
+                _currentT = 1.0;
+            randomizeCurrent();
+            _current->compute();
+        }
+
+        /*! Runs some initial annealing iterations in order to set the temperature to
+         * the proper initial value. */
+        void tuneTemperature() {
+            int acceptedWorse, uphill;
+            do {
+                acceptedWorse = uphill = 0;
+                for (uint32_t count = 0, check = _checkInterval; count < _maxIterations; count++) {
+                    bool worse;
+                    if (tryMove(worse) && worse)
+                        acceptedWorse++;
+                    if (worse)
+                        uphill++;
+                    improvesOnBest();
+                    if (0 == --check) {
+                        if (stopRequested()) {
+                            halt();
+                            return;
+                        }
+                        check = _checkInterval;
+                    }
+                }
+                if ((static_cast<double>(acceptedWorse) / static_cast<double>(uphill)) < _acceptProb)
+                    _currentT = 1.5 * _currentT;
+            } while ((static_cast<double>(acceptedWorse) / static_cast<double>(uphill)) < _acceptProb);
+            syncBest();
+        }
+
+        /*! Proposes a neighbor of the current solution and tests it for
+        superiority or inferiority, moving there if it passes.  Solutions which
+        satisfy ProposesMoves are priced in place, and only changed if the move
+        is accepted; anything else gets a whole neighbor built for it.
+
+        @param uphill Set true if the neighbor was no better than the current
+        solution
+        @return True if we moved to the neighbor */
+        bool tryMove(bool &uphill) {
+            PerformanceCounters::tally(_counters.proposals);
+            if constexpr (ProposesMoves<SolutionType, Engine>) {
+                auto move = PerformanceCounters::timed(_counters.generateNanoseconds,
+                                                       [this] { return _current->proposeMove(_prng); });
+                PerformanceCounters::timed(_counters.evaluateNanoseconds,
+                                           [this, &move] { _current->evaluateMove(move); });
+                if (!PerformanceCounters::timed(_counters.testNanoseconds,
+                                                [this, &move, &uphill] { return testNeigh(move.f, move.p, uphill); }))
+                    return false;
+                PerformanceCounters::timed(_counters.commitNanoseconds, [this, &move] {
+                    syncBest();
+                    _current->commitMove(move);
+                });
+            } else {
+                PerformanceCounters::timed(_counters.generateNanoseconds, [this] { generateNeighbor(); });
+                if (!PerformanceCounters::timed(_counters.testNanoseconds, [this, &uphill] {
+                    return testNeigh(_neighbor->getF(), _neighbor->getP(), uphill);
+                }))
+                    return false;
+                PerformanceCounters::timed(_counters.commitNanoseconds, [this] { acceptNeighbor(); });
+            }
+            PerformanceCounters::tally(_counters.acceptances);
+            if (uphill)
+                PerformanceCounters::tally(_counters.uphillAcceptances);
+            return true;
+        }
+
+        /*! Tests a neighbor for superiority or inferiority.
+
+        @param f The neighbor's feasible component
+        @param p The neighbor's penalty component
+        @param uphill Set true if the neighbor was no better than the current
+        solution
+        @return True if we should move to the neighbor */
+        bool testNeigh(const double f, const double p, bool &uphill) {
+            double delta = (f + _lambda * p) - (_current->getF() + _lambda * _current->getP());
+            uphill = !(delta < 0);
+            return !uphill || delta < _currentT * _exponentials(_prng);
+        }
+
+        /*! Updates the temperature and lambda each iteration. */
+        void updateParam() {
+            _currentT = _multiplierT * _currentT;
+            _lambda = _pfunc(_iterations);
+        }
+
+        std::shared_ptr<SolutionType> _best, _current, _neighbor;
+
+        uint32_t _bestIter, _iterations, _maxIterations{}, _minIterations{},
+                _terminalBestIter;
+        uint32_t _sampleSize{10000}, _sampleThreads{0};
+        double _multiplierT{}, _acceptProb{}, _currentT{};
+        PenaltyFunc _pfunc;
+        PenaltyType _lambda;
+        Engine _prng{randomSeed()};
+        ExponentialBatch<> _exponentials;
+
+        /*! Set when _current holds the best solution seen so far and _best is
+            out of date.  Keeping track of this lets us avoid copying a whole
+            solution every time the best one improves. */
+        bool _currentIsBest{false};
+
+        /*! Checks whether the current solution beats the best one seen so far.
+            If it does we don't copy it; we just remember that _current is the
+            best, and acceptNeighbor() or syncBest() catch _best up later.
+
+        @return True if the current solution is a new best */
+        bool improvesOnBest() {
+            if (_currentIsBest ||
+                !((_current->getP() < _best->getP()) ||
+                  (_current->getP() == _best->getP() && _current->getF() < _best->getF())))
+                return false;
+            _currentIsBest = true;
+            PerformanceCounters::tally(_counters.improvements);
+            return true;
+        }
+
+        /*! Makes the neighbor current.  If the outgoing current solution was
+            the best seen so far it becomes _best, and the old _best becomes
+            scratch space for the next neighbor: three pointer swaps rather than
+            a copy. */
+        void acceptNeighbor() {
+            _current.swap(_neighbor);
+            if (_currentIsBest) {
+                _best.swap(_neighbor);
+                _currentIsBest = false;
+            }
+        }
+
+        std::chrono::steady_clock::time_point _deadline{std::chrono::steady_clock::time_point::max()};
+        std::stop_token _stopToken;
+        uint32_t _checkInterval{1024};
+        bool _stopped{false};
+        [[no_unique_address]] Observer _observer;
+        PerformanceCounters _counters;
+        AdaptiveSchedule _schedule;
+        double _startT{};
+        uint32_t _frozenIterations{0}, _reheats{0};
+        bool _frozen{false};
+
+        /*! Applies the adaptive schedule, if there is one, after an iteration.
+
+        @param accepted The number of moves made during the iteration */
+        void adaptSchedule(const uint64_t accepted) {
+            if (0 == _schedule.window)
+                return;
+            if (static_cast<double>(accepted) > _schedule.frozenAcceptance * _maxIterations) {
+                _frozenIterations = 0;
+                return;
+            }
+            if (++_frozenIterations < _schedule.window || _bestIter <= _schedule.stagnation)
+                return;
+            _frozenIterations = 0;
+            if (_reheats < _schedule.maxReheats) {
+                _reheats += 1;
+                _currentT = _schedule.reheat * _startT;
+            } else if (_schedule.stopWhenFrozen && _iterations > _minIterations) {
+                _frozen = true;
+            }
+        }
+
+        /*! Returns true if we've been asked to stop or have run out of time. */
+        [[nodiscard]] bool stopRequested() const {
+            return _stopToken.stop_requested() ||
+                   (_deadline != std::chrono::steady_clock::time_point::max() &&
+                    std::chrono::steady_clock::now() >= _deadline);
+        }
+
+        /*! Stops early, making sure _best is up to date. */
+        void halt() {
+            _stopped = true;
+            improvesOnBest();
+            syncBest();
+        }
+
+        /*! Brings _best up to date, copying _current into it if need be. */
+        void syncBest() {
+            if (_currentIsBest) {
+                *_best = *_current;
+                _currentIsBest = false;
+            }
+        }
+
+        /*! Asks the current solution for a neighbor, handing it our own
+            generator if the SolutionType knows what to do with one. */
+        void generateNeighbor() {
+            if constexpr (requires { _current->generateNeighbor(*_neighbor, _prng); })
+                _current->generateNeighbor(*_neighbor, _prng);
+            else
+                _current->generateNeighbor(*_neighbor);
+        }
+
+        /*! Randomizes the current solution, handing it our own generator if
+            the SolutionType knows what to do with one. */
+        void randomizeCurrent() {
+            if constexpr (requires { _current->randomize(_prng); })
+                _current->randomize(_prng);
+            else
+                _current->randomize();
+        }
+    };
+
+    //! An Annealer specialized for Ohlmann-Thomas compressed annealing.
+    /*! For details on Ohlmann-Thomas annealing, please see:
+     *
+     * https://myweb.uiowa.edu/bthoa/DownloadItems/TSPTWpaper4-05-05.pdf
+
+        @author Hansen, Thiede
+        @since 2.1
+    */
+    template<class SolutionType, class Engine, class Observer>
+    class Annealer<Compression, SolutionType, Engine, Observer> {
+    public:
+        typedef Compression PenaltyFunc;
+        typedef PenaltyFunc::ReturnType PenaltyType;
+
+        /*!
+        An Annealer constructor which takes all necessary parameters in
+        one fell swoop.
+
+        @param pfunc The penalty function to be applied to this annealer
+        @param sol A solution, populated randomly, to be applied to this annealer
+        @param multT A value in the range 0.0 - 0.9999 representing the temperature
+        multiplier
+        @param accept A value in the range 0.0 - 0.9999 representing our willingness
+        to accept an inferior solution
+        @param tBI The terminal best iteration
+        @param minIter The minimum number of annealing iterations to apply
+        @param maxIter The maximum number of annealing iterations to apply
+        */
+        Annealer(const PenaltyFunc &pfunc, SolutionType &sol, double multT, double accept,
+                 uint32_t tBI, uint32_t minIter, uint32_t maxIter): _best(new SolutionType(sol)),
+                                                                    _current(new SolutionType(*_best)),
+                                                                    _neighbor(new SolutionType(*_best)),
+                                                                    _bestIter(0),
+                                                                    _iterations(0),
+                                                                    _maxIterations(maxIter),
+                                                                    _minIterations(minIter),
+                                                                    _terminalBestIter(tBI),
+                                                                    _multiplierT(multT),
+                                                                    _acceptProb(accept),
+                                                                    _currentT(0),
+                                                                    _pfunc(pfunc),
+                                                                    _lambda(0) {
+        }
+
+        /*! An Annealer constructor appropriate for use with PenaltyFuncs which have a
+        default constructor.
+
+        @param solution A solution, populated randomly, to be applied to this annealer
+        @param multT A value in the range 0.0 - 0.9999 representing the temperature
+        multiplier
+        @param accept A value in the range 0.0 - 0.9999 representing our willingness
+        to accept an inferior solution
+        @param tBI The terminal best iteration
+        @param minIter The minimum number of annealing iterations to apply
+        @param maxIter The maximum number of annealing iterations to apply
+        */
+
+        Annealer(SolutionType &solution, double multT, double accept, uint32_t tBI,
+                 uint32_t minIter, uint32_t maxIter): _best(new SolutionType(solution)),
+                                                      _current(new SolutionType(*_best)),
+                                                      _neighbor(new SolutionType(*_best)),
+                                                      _bestIter(0),
+                                                      _iterations(0),
+                                                      _maxIterations(maxIter),
+                                                      _minIterations(minIter),
+                                                      _terminalBestIter(tBI),
+                                                      _multiplierT(multT),
+                                                      _acceptProb(accept),
+                                                      _currentT(0),
+                                                      _lambda(0) {
+        }
+
+        /*! An Annealer constructor for use when the parameters will be set after
+        initialization.
+
+        @param pfunc The penalty function to be applied to this annealer
+        @param sol A solution, populated randomly, to be applied to this annealer
+        */
+        Annealer(const PenaltyFunc &pfunc, SolutionType &sol): _best(new SolutionType(sol)),
+                                                               _current(new SolutionType(*_best)),
+                                                               _neighbor(new SolutionType(*_best)),
+                                                               _bestIter(0),
+                                                               _iterations(0),
+                                                               _maxIterations(0),
+                                                               _minIterations(0),
+                                                               _terminalBestIter(0),
+                                                               _multiplierT(0),
+                                                               _acceptProb(0),
+                                                               _currentT(0),
+                                                               _pfunc(pfunc),
+                                                               _lambda(0) {
+        }
+
+        /*! A no-op destructor.
+
+        This destructor is virtualized to allow end users to subclass off this
+        template.  Whether an end user should subclass off this template is a
+        different question. */
+        virtual ~Annealer() = default;
+
+        /*! Returns this Annealer's PenaltyFunc */
+        PenaltyFunc &getPenaltyFunc() { return _pfunc; }
+
+        /*! Returns the best solution found by the annealer. */
+        const SolutionType &best() const { return *_best; }
+
+        /*! Returns the current solution in use by the annealer.
+
+        It is unlikely this method will be of use to end users.  Once you hit
+        the solve() method, you're on a trip to the end, or to the deadline or
+        stop request if you've set one.  However, in the event you want to
+        subclass and do funky things, you have an accessor. */
+        const SolutionType &current() const { return *_current; }
+
+        /*! For a completely-constructed annealer, initiate the solution process and
+         * do not return until termination, the deadline, or a stop request.
+
+        @return The best solution found */
+        const SolutionType &solve() {
+            start();
+            while (!finished())
+                step();
+            return *_best;
+        }
+
+        /*! Prepares to anneal: estimates the starting parameters and tunes the
+        temperature.  solve() is just start() followed by step() until
+        finished(); call them yourself if you need to do something between
+        iterations. */
+        void start() {
+            _stopped = false;
+            _currentIsBest = false;
+            *_current = *_best;
+            _best->setP(1000000);
+            initializeParam();
+            tuneTemperature();
+            _iterations = 0;
+            _startT = _currentT;
+            _frozenIterations = _reheats = 0;
+            _frozen = false;
+            _counters = {};
+        }
+
+        /*! Runs one annealing iteration: _maxIterations moves at the current
+        temperature, followed by a parameter update. */
+        void step() {
+            if (stopRequested()) {
+                halt();
+                return;
+            }
+            ++_iterations;
+            uint64_t accepted = 0;
+            [[maybe_unused]] uint64_t uphillMoves = 0;
+            for (uint32_t count = 0, check = _checkInterval; count < _maxIterations; ++count) {
+                bool uphill;
+                accepted += tryMove(uphill);
+                if constexpr (observerEnabled<Observer>)
+                    uphillMoves += uphill;
+                if (improvesOnBest())
+                    _bestIter = 1;
+                if (0 == --check) {
+                    if (stopRequested()) {
+                        halt();
+                        return;
+                    }
+                    check = _checkInterval;
+                }
+            }
+            syncBest();
+            if constexpr (observerEnabled<Observer>)
+                _observer(AnnealerProgress{
+                    _iterations, _currentT, static_cast<double>(_lambda), _current->getF(), _current->getP(),
+                    _best->getF(), _best->getP(), accepted, _maxIterations - accepted, uphillMoves
+                });
+            ++_bestIter;
+            updateParam();
+            adaptSchedule(accepted);
+        }
+
+        /*! Returns true once the termination criteria have been met, or once
+        we've stopped early. */
+        [[nodiscard]] bool finished() const {
+            return _stopped || _frozen ||
+                   !((_iterations <= _minIterations) || (_bestIter < _terminalBestIter));
+        }
+
+        /*! Sets up an adaptive temperature schedule.  It takes effect from the
+        next start() or solve().
+
+        @param schedule The schedule's settings
+        @throw std::invalid_argument if frozenAcceptance isn't in [0, 1) or
+        reheat isn't positive */
+        void setSchedule(const AdaptiveSchedule &schedule) {
+            if (!(schedule.frozenAcceptance >= 0.0 && schedule.frozenAcceptance < 1.0))
+                throw std::invalid_argument("frozen acceptance rate must be in [0, 1)");
+            if (!(schedule.reheat > 0.0))
+                throw std::invalid_argument("reheat fraction must be positive");
+            _schedule = schedule;
+        }
+
+        /*! Returns the adaptive temperature schedule's settings. */
+        [[nodiscard]] const AdaptiveSchedule &schedule() const { return _schedule; }
+
+        /*! Returns the number of times the last run reheated. */
+        [[nodiscard]] uint32_t reheats() const { return _reheats; }
+
+        /*! Returns true if the last run stopped because its search froze. */
+        [[nodiscard]] bool frozen() const { return _frozen; }
+
+        /*! Sets a time by which annealing must stop.  It's checked before each
+        iteration and every few moves within one (see setCheckInterval()); on
+        reaching it, the annealer stops with the best solution found so far.
+
+        @param deadline The time to stop by */
+        void setDeadline(const std::chrono::steady_clock::time_point deadline) { _deadline = deadline; }
+
+        /*! Sets a stop token which, once a stop is requested through it, makes
+        the annealer stop as it would at a deadline.  It's safe to request the
+        stop from another thread.
+
+        @param token The stop token to watch */
+        void setStopToken(std::stop_token token) { _stopToken = std::move(token); }
+
+        /*! Sets how many moves are made between checks of the deadline and stop
+        token within an iteration.  The default, 1024, costs nothing noticeable
+        and reacts within well under a millisecond on typical problems.
+
+        @param moves The number of moves between checks */
+        void setCheckInterval(const uint32_t moves) { _checkInterval = std::max<uint32_t>(1, moves); }
+
+        /*! Sets how many random solutions and neighbors are sampled to choose
+        the starting temperature and pressure cap.  Fewer samples make for a quicker start
+        and a rougher estimate.
+
+        @param samples The number of solutions and neighbors, counted together,
+        as the default of 10,000 is
+        @throw std::invalid_argument if samples is less than 2 */
+        void setSampleSize(const uint32_t samples) {
+            if (samples < 2)
+                throw std::invalid_argument("sample size must be at least 2");
+            _sampleSize = samples;
+        }
+
+        /*! Returns the number of random solutions and neighbors sampled. */
+        [[nodiscard]] uint32_t sampleSize() const { return _sampleSize; }
+
+        /*! Sets the most threads sampling may use.  The default, 0, means one
+        per hardware thread; when many annealers are running at once, 1 is
+        better.  The result doesn't depend on it.
+
+        @param threads The most threads to use */
+        void setSampleThreads(const uint32_t threads) { _sampleThreads = threads; }
+
+        /*! Returns true if the last run was cut short by the deadline or a stop
+        request. */
+        [[nodiscard]] bool stopped() const { return _stopped; }
+
+        /*! Replaces this annealer's observer.
+
+        @param observer The observer to call after each iteration */
+        void setObserver(Observer observer) { _observer = std::move(observer); }
+
+        /*! Returns this annealer's observer. */
+        Observer &observer() { return _observer; }
+
+        /*! Replaces the current solution, leaving the temperature, lambda and
+        best solution alone.  Annealing carries on from the new solution at the
+        next step().
+
+        @param sol The solution to carry on from */
+        void restartFrom(const SolutionType &sol) {
+            syncBest();
+            *_current = sol;
+        }
+
+        /*! Return a std::string representation of the best solution found by the
+        annealer.
+
+        @return A std::string representation of the best solution found by the
+        annealer. */
+        [[nodiscard]] std::string solution() const {
+            std::stringstream ss;
+            ss << (*_best);
+            std::string result = ss.str();
+            return result;
+        }
+
+        /*! Sets the parameters of the annealer.
+
+        @param multT A value in the range 0.0 - 0.9999 representing the temperature
+        multiplier
+        @param accept A value in the range 0.0 - 0.9999 representing our willingness
+        to accept an inferior solution
+        @param tBI The terminal best iteration
+        @param minIterations The minimum number of annealing iterations to apply
+        @param maxIterations The maximum number of annealing iterations to apply */
+        void setParameters(double multT, double accept, uint32_t tBI,
+                           uint32_t minIterations, uint32_t maxIterations) {
+            _multiplierT = multT;
+            _acceptProb = accept;
+            _terminalBestIter = tBI;
+            _minIterations = minIterations;
+            _maxIterations = maxIterations;
+        }
+
+        /*! Sets the parameters of this annealer's SolutionType by calling that class'
+        constructor.
+
+        @param foo A char* containing the solution parameters */
+        void setSolutionParameters(const char *foo) {
+            _best = std::make_shared<SolutionType>(foo);
+            _current = std::make_shared<SolutionType>(*_best);
+            _neighbor = std::make_shared<SolutionType>(*_best);
+        }
+
+        /*! Allows for an Annealer object's internal state to be dumped in
+        human-readable format to an output stream.
+
+        Please note that this is not meant to be called directly.  Rather, an
+        operator<< will be set up as a proxy to invoke this method.
+
+        @param os The output stream to dump it to
+        @return The output stream os after the operation completes */
+        std::ostream &dump(std::ostream &os) const {
+            os << "{\n\t\"best_solution\": {\n\t\t\"base_cost\": "
+                    << (_best->getF()) << ",\n\t\t\"penalty\":   "
+                    << (_best->getP()) << "\n\t},\n\t"
+                    << "\"best_iteration\":          " << _bestIter << ",\n\t"
+                    << "\"iterations\":              " << _iterations << ",\n\t"
+                    << "\"count_limit\":             " << _maxIterations << ",\n\t"
+                    << "\"minimum_iterations\":      " << _minIterations << ",\n\t"
+                    << "\"sample_size\":             " << _sampleSize << ",\n\t"
+                    << "\"multiplier\":              " << _multiplierT << ",\n\t"
+                    << "\"acceptance_probability\":  " << _acceptProb << ",\n\t"
+                    << "\"terminal_best_iteration\": " << _terminalBestIter << ",\n\t"
+                    << "\"pressure\":                " << _lambda;
+#ifdef USE_PERFORMANCE_COUNTERS
+            os << ",\n\t\"performance_counters\": {\n";
+            _counters.dump(os, "\t\t") << "\t}";
+#endif
+            os << "\n}\n";
+            return os;
+        }
+
+        /*! Returns what this annealer has been doing and where its time went.
+        Everything stays zero unless USE_PERFORMANCE_COUNTERS is defined. */
+        [[nodiscard]] const PerformanceCounters &counters() const { return _counters; }
+
+        /*! Returns the cost of the best solution found by the annealer.
+
+        @return The cost of the best solution found by the annealer.*/
+        [[nodiscard]] double cost() const { return _best->getF(); }
+
+        /*! Returns the penalty incurred by the best solution found by the annealer.
+
+        @return The penalty incurred by the best solution found by the annealer. */
+        [[nodiscard]] double penalty() const { return _best->getP(); }
+        /*! Returns the number of the iteration on which the best solution was
+        encountered.
+
+        @return The number of the iteration on which the best solution was
+        encountered. */
+        [[nodiscard]] uint32_t bestIter() const { return _bestIter; }
+
+        /*! Returns the current iteration number.
+
+        @return The current iteration number. */
+        [[nodiscard]] uint32_t iterations() const { return _iterations; }
+
+        /*! Returns the maximum number of annealer iterations to run.
+
+        @return The maximum number of annealer iterations to run. */
+        [[nodiscard]] uint32_t maxIterations() const { return _maxIterations; }
+
+        /*! Returns the minimum number of annealer iterations to run.
+
+        @return The minimum number of annealer iterations to run. */
+        [[nodiscard]] uint32_t minIterations() const { return _minIterations; }
+        /*! Returns the temperature multiplier.
+
+        @return The temperature multiplier. */
+        [[nodiscard]] double multiplier() const { return _multiplierT; }
+
+        /*! Returns the probability of accepting an inferior move.
+
+        @return The probability of accepting an inferior move. */
+        [[nodiscard]] double probability() const { return _acceptProb; }
+        /*! Reseeds this annealer's random number generator.  Two annealers
+        built from the same solution, given the same parameters and seed, will
+        follow exactly the same path.
+
+        @param seed The new seed */
+        void seed(const uint64_t seed) {
+            _prng.seed(seed);
+            _exponentials.reset();
+        }
+
+        /*! Returns this annealer's random number generator.
+
+        @return This annealer's random number generator. */
+        Engine &engine() { return _prng; }
+
+        /*! Returns the current lambda.
+
+        @return The current lambda. */
+        [[nodiscard]] PenaltyType getLambda() const { return _lambda; }
+
+    protected:
+        /*! Performs housekeeping to make sure our parameters are properly set before
+         * entering annealing runs. */
+        void initializeParam() {
+            double solutionScalePressure = _pfunc.getCapPercentage() / (1 - _pfunc.getCapPercentage());
+            const auto sample = sampleParameters<SolutionType, Engine>(*_current, _sampleSize / 2,
+                                                                       solutionScalePressure, _prng(),
+                                                                       _sampleThreads);
+            _pfunc.setPressureCap(sample.cap);
+            _currentT = ((-1 * sample.spread / _sampleSize) / log(_acceptProb));
+            // No sampled move changed F (every way round a tour of one or two
+            // customers costs the same), and tuneTemperature() can't raise a
+            // temperature of zero; start it from one instead.
+            if (0.0 == sample.spread)
+                _currentT = 1.0;
+            randomizeCurrent();
+            _current->compute();
+        }
+
+        /*! Run some initial annealing iterations in order to set the temperature to
+         * the proper initial value. */
+        void tuneTemperature() {
+            int acceptedWorse, uphill;
+            uint32_t iterations = 0;
+            do {
+                ++iterations;
+                acceptedWorse = uphill = 0;
+                for (uint32_t count = 0, check = _checkInterval; count < _maxIterations; count++) {
+                    bool worse;
+                    if (tryMove(worse) && worse)
+                        acceptedWorse++;
+                    if (worse)
+                        uphill++;
+                    improvesOnBest();
+                    if (0 == --check) {
+                        if (stopRequested()) {
+                            halt();
+                            return;
+                        }
+                        check = _checkInterval;
+                    }
+                }
+                if ((static_cast<double>(acceptedWorse) / static_cast<double>(uphill)) < _acceptProb)
+                    _currentT = 1.5 * _currentT;
+            } while ((static_cast<double>(acceptedWorse) / static_cast<double>(uphill)) < _acceptProb);
+            syncBest();
+        }
+
+        /*! Proposes a neighbor of the current solution and tests it for
+        superiority or inferiority, moving there if it passes.  Solutions which
+        satisfy ProposesMoves are priced in place, and only changed if the move
+        is accepted; anything else gets a whole neighbor built for it.
+
+        @param uphill Set true if the neighbor was no better than the current
+        solution
+        @return True if we moved to the neighbor */
+        bool tryMove(bool &uphill) {
+            PerformanceCounters::tally(_counters.proposals);
+            if constexpr (ProposesMoves<SolutionType, Engine>) {
+                auto move = PerformanceCounters::timed(_counters.generateNanoseconds,
+                                                       [this] { return _current->proposeMove(_prng); });
+                PerformanceCounters::timed(_counters.evaluateNanoseconds,
+                                           [this, &move] { _current->evaluateMove(move); });
+                if (!PerformanceCounters::timed(_counters.testNanoseconds,
+                                                [this, &move, &uphill] { return testNeigh(move.f, move.p, uphill); }))
+                    return false;
+                PerformanceCounters::timed(_counters.commitNanoseconds, [this, &move] {
+                    syncBest();
+                    _current->commitMove(move);
+                });
+            } else {
+                PerformanceCounters::timed(_counters.generateNanoseconds, [this] { generateNeighbor(); });
+                if (!PerformanceCounters::timed(_counters.testNanoseconds, [this, &uphill] {
+                    return testNeigh(_neighbor->getF(), _neighbor->getP(), uphill);
+                }))
+                    return false;
+                PerformanceCounters::timed(_counters.commitNanoseconds, [this] { acceptNeighbor(); });
+            }
+            PerformanceCounters::tally(_counters.acceptances);
+            if (uphill)
+                PerformanceCounters::tally(_counters.uphillAcceptances);
+            return true;
+        }
+
+        /*! Tests a neighbor for superiority or inferiority.
+
+        @param f The neighbor's feasible component
+        @param p The neighbor's penalty component
+        @param uphill Set true if the neighbor was no better than the current
+        solution
+        @return True if we should move to the neighbor */
+        bool testNeigh(const double f, const double p, bool &uphill) {
+            double delta = (f + _lambda * p) - (_current->getF() + _lambda * _current->getP());
+            uphill = !(delta < 0);
+            return !uphill || delta < _currentT * _exponentials(_prng);
+        }
+
+        /*! Updates the temperature and lambda each iteration. */
+        void updateParam() {
+            _currentT = _multiplierT * _currentT;
+            _lambda = _pfunc(_iterations);
+        }
+
+        std::shared_ptr<SolutionType> _best, _current, _neighbor;
+
+        uint32_t _bestIter, _iterations, _maxIterations, _minIterations,
+                _terminalBestIter;
+        uint32_t _sampleSize{10000}, _sampleThreads{0};
+        double _multiplierT, _acceptProb, _currentT;
+        PenaltyFunc _pfunc;
+        PenaltyType _lambda;
+        Engine _prng{randomSeed()};
+        ExponentialBatch<> _exponentials;
+
+        /*! Set when _current holds the best solution seen so far and _best is
+            out of date.  Keeping track of this lets us avoid copying a whole
+            solution every time the best one improves. */
+        bool _currentIsBest{false};
+
+        /*! Checks whether the current solution beats the best one seen so far.
+            If it does we don't copy it; we just remember that _current is the
+            best, and acceptNeighbor() or syncBest() catch _best up later.
+
+        @return True if the current solution is a new best */
+        bool improvesOnBest() {
+            if (_currentIsBest ||
+                !((_current->getP() < _best->getP()) ||
+                  (_current->getP() == _best->getP() && _current->getF() < _best->getF())))
+                return false;
+            _currentIsBest = true;
+            PerformanceCounters::tally(_counters.improvements);
+            return true;
+        }
+
+        /*! Makes the neighbor current.  If the outgoing current solution was
+            the best seen so far it becomes _best, and the old _best becomes
+            scratch space for the next neighbor: three pointer swaps rather than
+            a copy. */
+        void acceptNeighbor() {
+            _current.swap(_neighbor);
+            if (_currentIsBest) {
+                _best.swap(_neighbor);
+                _currentIsBest = false;
+            }
+        }
+
+        std::chrono::steady_clock::time_point _deadline{std::chrono::steady_clock::time_point::max()};
+        std::stop_token _stopToken;
+        uint32_t _checkInterval{1024};
+        bool _stopped{false};
+        [[no_unique_address]] Observer _observer;
+        PerformanceCounters _counters;
+        AdaptiveSchedule _schedule;
+        double _startT{};
+        uint32_t _frozenIterations{0}, _reheats{0};
+        bool _frozen{false};
+
+        /*! Applies the adaptive schedule, if there is one, after an iteration.
+
+        @param accepted The number of moves made during the iteration */
+        void adaptSchedule(const uint64_t accepted) {
+            if (0 == _schedule.window)
+                return;
+            if (static_cast<double>(accepted) > _schedule.frozenAcceptance * _maxIterations) {
+                _frozenIterations = 0;
+                return;
+            }
+            if (++_frozenIterations < _schedule.window || _bestIter <= _schedule.stagnation)
+                return;
+            _frozenIterations = 0;
+            if (_reheats < _schedule.maxReheats) {
+                _reheats += 1;
+                _currentT = _schedule.reheat * _startT;
+            } else if (_schedule.stopWhenFrozen && _iterations > _minIterations) {
+                _frozen = true;
+            }
+        }
+
+        /*! Returns true if we've been asked to stop or have run out of time. */
+        [[nodiscard]] bool stopRequested() const {
+            return _stopToken.stop_requested() ||
+                   (_deadline != std::chrono::steady_clock::time_point::max() &&
+                    std::chrono::steady_clock::now() >= _deadline);
+        }
+
+        /*! Stops early, making sure _best is up to date. */
+        void halt() {
+            _stopped = true;
+            improvesOnBest();
+            syncBest();
+        }
+
+        /*! Brings _best up to date, copying _current into it if need be. */
+        void syncBest() {
+            if (_currentIsBest) {
+                *_best = *_current;
+                _currentIsBest = false;
+            }
+        }
+
+        /*! Asks the current solution for a neighbor, handing it our own
+            generator if the SolutionType knows what to do with one. */
+        void generateNeighbor() {
+            if constexpr (requires { _current->generateNeighbor(*_neighbor, _prng); })
+                _current->generateNeighbor(*_neighbor, _prng);
+            else
+                _current->generateNeighbor(*_neighbor);
+        }
+
+        /*! Randomizes the current solution, handing it our own generator if
+            the SolutionType knows what to do with one. */
+        void randomizeCurrent() {
+            if constexpr (requires { _current->randomize(_prng); })
+                _current->randomize(_prng);
+            else
+                _current->randomize();
+        }
+    };
+
+    //! An annealer which runs several replicas of a problem at once, each at
+    //! its own temperature, and lets neighboring replicas trade places.
+
+    /*! Replica exchange (also called parallel tempering) keeps M searches going
+        on a geometric ladder of temperatures.  The hottest replica starts at
+        the temperature an ordinary Annealer would pick, and each replica below
+        it is colder by a constant ratio.  Each replica anneals on its own
+        thread.  Every so often, adjacent replicas i and j offer to swap
+        states.  They accept with the Metropolis probability
+        min(1, exp((1/T_i - 1/T_j)(E_i - E_j))).  A cold replica stuck in a
+        bad basin can then be rescued by a hotter one that has found a better
+        region.
+
+        Energies are F + lambda * P.  Once per outer iteration the whole ladder
+        is cooled by the multiplier and lambda is taken from the penalty
+        function, exactly as in Annealer.  For Compression, the pressure cap
+        is estimated from random tours as Annealer<Compression, ...> does.
+
+        Each replica has its own generator seeded from seed(), so a given seed
+        gives the same result however the replicas are scheduled.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class PenaltyFunc, class SolutionType, class Engine = std::mt19937_64>
+    class ReplicaExchangeAnnealer {
+    public:
+        typedef typename PenaltyFunc::ReturnType PenaltyType;
+
+        /*!
+        A ReplicaExchangeAnnealer constructor which takes the same parameters
+        as an Annealer.  The ladder defaults to one replica per hardware thread,
+        each 1.5 times colder than the next, exchanging every 1000 moves.
+
+        @param pfunc The penalty function to be applied to this annealer
+        @param sol A solution to be applied to this annealer
+        @param multT A value in the range 0.0 - 0.9999 representing the temperature
+        multiplier
+        @param accept A value in the range 0.0 - 0.9999 representing our willingness
+        to accept an inferior solution
+        @param tBI The terminal best iteration
+        @param minIter The minimum number of annealing iterations to apply
+        @param maxIter The number of moves each replica makes per iteration
+        */
+        ReplicaExchangeAnnealer(const PenaltyFunc &pfunc, SolutionType &sol, double multT, double accept,
+                                uint32_t tBI, uint32_t minIter, uint32_t maxIter): _best(new SolutionType(sol)),
+            _start(new SolutionType(sol)),
+            _bestIter(0),
+            _iterations(0),
+            _maxIterations(maxIter),
+            _minIterations(minIter),
+            _terminalBestIter(tBI),
+            _replicaCount(std::max<uint32_t>(2, hardwareThreads())),
+            _exchangeInterval(1000),
+            _multiplierT(multT),
+            _acceptProb(accept),
+            _ladderRatio(1.5),
+            _pfunc(pfunc),
+            _lambda(PenaltyFunc::defaultReturnTypeValue) {
+        }
+
+        /*! A no-op destructor, virtualized for the benefit of subclasses. */
+        virtual ~ReplicaExchangeAnnealer() = default;
+
+        /*! Sets the shape of the temperature ladder.
+
+        @param replicas The number of replicas, at least 2
+        @param ratio The ratio between adjacent temperatures, greater than 1
+        @throw std::invalid_argument if ratio isn't greater than 1 */
+        void setReplicas(const uint32_t replicas, const double ratio) {
+            if (!(ratio > 1.0))
+                throw std::invalid_argument("ladder ratio must be greater than 1");
+            _replicaCount = std::max<uint32_t>(2, replicas);
+            _ladderRatio = ratio;
+        }
+
+        /*! Sets how many moves each replica makes between exchange attempts.
+
+        @param moves The number of moves between exchanges */
+        void setExchangeInterval(const uint32_t moves) { _exchangeInterval = std::max<uint32_t>(1, moves); }
+
+        /*! Reseeds the annealer.
+
+        @param seed The new seed */
+        void seed(const uint64_t seed) {
+            _seed = seed;
+            _prng.seed(seed);
+        }
+
+        /*! Sets a time by which annealing must stop.  It's checked between
+        exchanges; on reaching it, solve() returns with the best solution found
+        so far.
+
+        @param deadline The time to stop by */
+        void setDeadline(const std::chrono::steady_clock::time_point deadline) { _deadline = deadline; }
+
+        /*! Sets a stop token which, once a stop is requested through it, makes
+        solve() stop as it would at a deadline.
+
+        @param token The stop token to watch */
+        void setStopToken(std::stop_token token) { _stopToken = std::move(token); }
+
+        /*! Sets how many random solutions and neighbors are sampled to choose
+        the starting temperature of the hottest replica (and, for Compression, the pressure cap).  Fewer samples make for a quicker start
+        and a rougher estimate.
+
+        @param samples The number of solutions and neighbors, counted together,
+        as the default of 10,000 is
+        @throw std::invalid_argument if samples is less than 2 */
+        void setSampleSize(const uint32_t samples) {
+            if (samples < 2)
+                throw std::invalid_argument("sample size must be at least 2");
+            _sampleSize = samples;
+        }
+
+        /*! Returns the number of random solutions and neighbors sampled. */
+        [[nodiscard]] uint32_t sampleSize() const { return _sampleSize; }
+
+        /*! Sets the most threads sampling may use.  The default, 0, means one
+        per hardware thread; when many annealers are running at once, 1 is
+        better.  The result doesn't depend on it.
+
+        @param threads The most threads to use */
+        void setSampleThreads(const uint32_t threads) { _sampleThreads = threads; }
+
+        /*! Returns true if the last run was cut short by the deadline or a stop
+        request. */
+        [[nodiscard]] bool stopped() const { return _stopped; }
+
+        /*! Runs the replicas to termination, the deadline, or a stop request.
+
+        @return The best solution found */
+        const SolutionType &solve() {
+            ThreadPool pool(_replicaCount);
+            SplitMix64 seeds(_seed);
+            _replicas.clear();
+            _replicas.reserve(_replicaCount);
+            for (uint32_t i = 0; i < _replicaCount; i += 1)
+                _replicas.emplace_back(*_start, seeds());
+            _exchangeAttempts = _exchangeAccepts = 0;
+            *_best = *_start;
+            _best->setP(1000000);
+            _lambda = PenaltyFunc::defaultReturnTypeValue;
+            initializeParam();
+
+            _iterations = 0;
+            _stopped = false;
+            _counters = {};
+            uint32_t parity = 0;
+            std::vector<std::future<void> > sweeps(_replicaCount);
+            while ((_iterations <= _minIterations) || (_bestIter < _terminalBestIter)) {
+                ++_iterations;
+                for (uint32_t done = 0; done < _maxIterations && !_stopped; done += _exchangeInterval) {
+                    const uint32_t moves = std::min(_exchangeInterval, _maxIterations - done);
+                    for (uint32_t i = 0; i < _replicaCount; i += 1)
+                        sweeps[i] = pool.submit([this, i, moves]() { sweep(_replicas[i], moves); });
+                    for (auto &s: sweeps)
+                        s.get();
+                    exchange(parity);
+                    parity ^= 1;
+                    _stopped = _stopToken.stop_requested() || std::chrono::steady_clock::now() >= _deadline;
+                }
+                if (collectBest())
+                    _bestIter = 1;
+                collectCounters();
+                if (_stopped)
+                    break;
+                ++_bestIter;
+                updateParam();
+            }
+            return *_best;
+        }
+
+        /*! Returns the best solution found by any replica. */
+        const SolutionType &best() const { return *_best; }
+
+        /*! Return a std::string representation of the best solution found. */
+        [[nodiscard]] std::string solution() const {
+            std::stringstream ss;
+            ss << (*_best);
+            return ss.str();
+        }
+
+        /*! Returns the cost of the best solution found. */
+        [[nodiscard]] double cost() const { return _best->getF(); }
+
+        /*! Returns the penalty incurred by the best solution found. */
+        [[nodiscard]] double penalty() const { return _best->getP(); }
+
+        /*! Returns the number of the iteration on which the best solution was
+        encountered. */
+        [[nodiscard]] uint32_t bestIter() const { return _bestIter; }
+
+        /*! Returns the current iteration number. */
+        [[nodiscard]] uint32_t iterations() const { return _iterations; }
+
+        /*! Returns the fraction of attempted exchanges which were accepted. */
+        [[nodiscard]] double exchangeRate() const {
+            return _exchangeAttempts ? static_cast<double>(_exchangeAccepts) / _exchangeAttempts : 0.0;
+        }
+
+        /*! Returns the current lambda. */
+        [[nodiscard]] PenaltyType getLambda() const { return _lambda; }
+
+        /*! Returns what the replicas have been doing and where their time
+        went, totalled over all of them as of the last iteration.  Everything
+        stays zero unless USE_PERFORMANCE_COUNTERS is defined. */
+        [[nodiscard]] const PerformanceCounters &counters() const { return _counters; }
+
+        /*! Dumps this annealer's state to an output stream as JSON.
+
+        @param os The output stream to dump it to
+        @return The output stream os after the operation completes */
+        std::ostream &dump(std::ostream &os) const {
+            os << "{\n\t\"best_solution\": {\n\t\t\"base_cost\": "
+                    << (_best->getF()) << ",\n\t\t\"penalty\":   "
+                    << (_best->getP()) << "\n\t},\n\t"
+                    << "\"best_iteration\":          " << _bestIter << ",\n\t"
+                    << "\"iterations\":              " << _iterations << ",\n\t"
+                    << "\"count_limit\":             " << _maxIterations << ",\n\t"
+                    << "\"minimum_iterations\":      " << _minIterations << ",\n\t"
+                    << "\"sample_size\":             " << _sampleSize << ",\n\t"
+                    << "\"replicas\":                " << _replicaCount << ",\n\t"
+                    << "\"ladder_ratio\":            " << _ladderRatio << ",\n\t"
+                    << "\"exchange_interval\":       " << _exchangeInterval << ",\n\t"
+                    << "\"exchange_rate\":           " << exchangeRate() << ",\n\t"
+                    << "\"multiplier\":              " << _multiplierT << ",\n\t"
+                    << "\"acceptance_probability\":  " << _acceptProb << ",\n\t"
+                    << "\"terminal_best_iteration\": " << _terminalBestIter << ",\n\t"
+                    << "\"pressure\":                " << _lambda;
+#ifdef USE_PERFORMANCE_COUNTERS
+            os << ",\n\t\"performance_counters\": {\n";
+            _counters.dump(os, "\t\t") << "\t}";
+#endif
+            os << "\n}\n";
+            return os;
+        }
+
+    protected:
+        /*! One rung of the temperature ladder. */
+        struct Replica {
+            Replica(const SolutionType &sol, const uint64_t seed)
+                : current(new SolutionType(sol)),
+                  neighbor(new SolutionType(sol)),
+                  best(new SolutionType(sol)),
+                  prng(seed) {
+                best->setP(1000000);
+            }
+
+            std::shared_ptr<SolutionType> current, neighbor, best;
+            Engine prng;
+            ExponentialBatch<> exponentials;
+            double temperature{0};
+            bool improved{false};
+            bool currentIsBest{false};
+            PerformanceCounters counters;
+        };
+
+        /*! Estimates the starting temperature (and, for Compression, the
+            pressure cap) from random tours, then spreads the replicas down
+            the ladder from it and gives each one a random starting tour. */
+        void initializeParam() {
+            double solutionScalePressure = 0;
+            if constexpr (std::is_same_v<PenaltyFunc, Compression>)
+                solutionScalePressure = _pfunc.getCapPercentage() / (1 - _pfunc.getCapPercentage());
+            const auto sample = sampleParameters<SolutionType, Engine>(*_start, _sampleSize / 2,
+                                                                       solutionScalePressure, _prng(),
+                                                                       _sampleThreads);
+            if constexpr (std::is_same_v<PenaltyFunc, Compression>)
+                _pfunc.setPressureCap(sample.cap);
+            // As in Annealer, a sample in which no move changed F gives no
+            // scale to work from, so the ladder starts from one.
+            const double hottest = 0.0 == sample.spread ? 1.0 : (-1 * sample.spread / _sampleSize) / log(_acceptProb);
+            for (uint32_t i = 0; i < _replicaCount; i += 1) {
+                Replica &r = _replicas[i];
+                r.temperature = hottest / std::pow(_ladderRatio, _replicaCount - 1 - i);
+                randomize(*r.current, r.prng);
+                r.current->compute();
+            }
+        }
+
+        /*! Makes a number of ordinary annealing moves on one replica.  As in
+            Annealer, a new best is only copied once the replica moves away
+            from it, and then by swapping pointers where possible. */
+        void sweep(Replica &r, const uint32_t moves) const {
+            PerformanceCounters &counters = r.counters;
+            for (uint32_t count = 0; count < moves; ++count) {
+                const double currentE = r.current->getF() + _lambda * r.current->getP();
+                double delta;
+                bool accepted;
+                PerformanceCounters::tally(counters.proposals);
+                if constexpr (ProposesMoves<SolutionType, Engine>) {
+                    auto move = PerformanceCounters::timed(counters.generateNanoseconds,
+                                                           [&r] { return r.current->proposeMove(r.prng); });
+                    PerformanceCounters::timed(counters.evaluateNanoseconds,
+                                               [&r, &move] { r.current->evaluateMove(move); });
+                    delta = (move.f + _lambda * move.p) - currentE;
+                    accepted = PerformanceCounters::timed(counters.testNanoseconds, [&r, delta] {
+                        return delta < 0 || delta < r.temperature * r.exponentials(r.prng);
+                    });
+                    if (accepted)
+                        PerformanceCounters::timed(counters.commitNanoseconds, [&r, &move] {
+                            if (r.currentIsBest) {
+                                *r.best = *r.current;
+                                r.currentIsBest = false;
+                            }
+                            r.current->commitMove(move);
+                        });
+                } else {
+                    PerformanceCounters::timed(counters.generateNanoseconds,
+                                               [&r] { generateNeighbor(*r.current, *r.neighbor, r.prng); });
+                    delta = (r.neighbor->getF() + _lambda * r.neighbor->getP()) - currentE;
+                    accepted = PerformanceCounters::timed(counters.testNanoseconds, [&r, delta] {
+                        return delta < 0 || delta < r.temperature * r.exponentials(r.prng);
+                    });
+                    if (accepted)
+                        PerformanceCounters::timed(counters.commitNanoseconds, [&r] {
+                            r.current.swap(r.neighbor);
+                            if (r.currentIsBest) {
+                                r.best.swap(r.neighbor);
+                                r.currentIsBest = false;
+                            }
+                        });
+                }
+                if (accepted) {
+                    PerformanceCounters::tally(counters.acceptances);
+                    if (!(delta < 0))
+                        PerformanceCounters::tally(counters.uphillAcceptances);
+                }
+                if (!r.currentIsBest &&
+                    ((r.current->getP() < r.best->getP()) ||
+                     (r.current->getP() == r.best->getP() && r.current->getF() < r.best->getF()))) {
+                    r.currentIsBest = true;
+                    r.improved = true;
+                    PerformanceCounters::tally(counters.improvements);
+                }
+            }
+            if (r.currentIsBest) {
+                *r.best = *r.current;
+                r.currentIsBest = false;
+            }
+        }
+
+        /*! Offers a swap to every other pair of adjacent replicas, starting
+            with the coldest pair or the one above it. */
+        void exchange(const uint32_t parity) {
+            for (uint32_t i = parity; i + 1 < _replicaCount; i += 2) {
+                Replica &cold = _replicas[i];
+                Replica &hot = _replicas[i + 1];
+                const double coldE = cold.current->getF() + _lambda * cold.current->getP();
+                const double hotE = hot.current->getF() + _lambda * hot.current->getP();
+                const double u = (1 / cold.temperature - 1 / hot.temperature) * (coldE - hotE);
+                ++_exchangeAttempts;
+                if (u >= 0 || _urd(_prng) < exp(u)) {
+                    cold.current.swap(hot.current);
+                    ++_exchangeAccepts;
+                }
+            }
+        }
+
+        /*! Folds each replica's best into the overall best.
+
+        @return True if the overall best improved */
+        bool collectBest() {
+            bool improved = false;
+            for (Replica &r: _replicas) {
+                if (!r.improved)
+                    continue;
+                r.improved = false;
+                if ((r.best->getP() < _best->getP()) ||
+                    (r.best->getP() == _best->getP() && r.best->getF() < _best->getF())) {
+                    *_best = *r.best;
+                    improved = true;
+                }
+            }
+            return improved;
+        }
+
+        /*! Totals the replicas' performance counters. */
+        void collectCounters() {
+            _counters = {};
+            for (const Replica &r: _replicas)
+                _counters += r.counters;
+        }
+
+        /*! Cools the whole ladder and updates lambda. */
+        void updateParam() {
+            for (Replica &r: _replicas)
+                r.temperature *= _multiplierT;
+            _lambda = _pfunc(_iterations);
+        }
+
+        static void generateNeighbor(SolutionType &current, SolutionType &neighbor, Engine &prng) {
+            if constexpr (requires { current.generateNeighbor(neighbor, prng); })
+                current.generateNeighbor(neighbor, prng);
+            else
+                current.generateNeighbor(neighbor);
+        }
+
+        static void randomize(SolutionType &sol, Engine &prng) {
+            if constexpr (requires { sol.randomize(prng); })
+                sol.randomize(prng);
+            else
+                sol.randomize();
+        }
+
+        std::shared_ptr<SolutionType> _best, _start;
+        std::vector<Replica> _replicas;
+        uint32_t _bestIter, _iterations, _maxIterations, _minIterations, _terminalBestIter;
+        uint32_t _replicaCount, _exchangeInterval;
+        uint32_t _sampleSize{10000}, _sampleThreads{0};
+        double _multiplierT, _acceptProb, _ladderRatio;
+        uint64_t _exchangeAttempts{0}, _exchangeAccepts{0};
+        PerformanceCounters _counters;
+        PenaltyFunc _pfunc;
+        PenaltyType _lambda;
+        uint64_t _seed{randomSeed()};
+        Engine _prng{_seed};
+        std::chrono::steady_clock::time_point _deadline{std::chrono::steady_clock::time_point::max()};
+        std::stop_token _stopToken;
+        bool _stopped{false};
+        std::uniform_real_distribution<> _urd{0.0, 1.0};
+    };
+
+    /*! An operator<< which serves as a proxy for a ReplicaExchangeAnnealer's
+       dump() method.
+
+        @param os The output stream to write to
+        @param engine The ReplicaExchangeAnnealer to be written
+        @return The output stream after the ReplicaExchangeAnnealer is written */
+    template<class PenaltyFunc, class SolutionType, class Engine>
+    std::ostream &operator<<(std::ostream &os,
+                             const ReplicaExchangeAnnealer<PenaltyFunc, SolutionType, Engine> &engine) {
+        return engine.dump(os);
+    }
+
+    /*! An overridden operator<< which serves as a proxy for an Annealer's dump()
+       method.
+
+        @param os The output stream to write the Annealer to
+        @param engine The Annealer to be written
+        @return The output stream after the Annealer is written */
+    template<class PenaltyFunc, class SolutionType, class Engine, class Observer>
+    std::ostream &operator<<(std::ostream &os,
+                             const Annealer<PenaltyFunc, SolutionType, Engine, Observer> &engine) {
+        return engine.dump(os);
+    }
+}
+
+
+#endif
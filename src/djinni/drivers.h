@@ -0,0 +1,488 @@
+/* Copyright (c) 2004 - 2025, Robert J. Hansen <rjh@sixdemonbag.org>
+ * and Tristan D. Thiede (address currently unknown).
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose with or without fee is hereby granted, provided
+ * that the above copyright notice and this permission notice appear
+ * in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE. */
+
+#ifndef DRIVERS_H
+#define DRIVERS_H
+
+#include "annealers.h"
+#include "parallel.h"
+#include "random.h"
+#include <algorithm>
+#include <barrier>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+
+namespace edu::uiowa::tippie::djinni {
+    //! What happened during one annealing run of a multi-run driver.
+
+    /*! @author Hansen
+        @since 2.5
+    */
+    struct RunStatistics {
+        uint32_t run{0};
+        uint64_t seed{0};
+        double cost{0};
+        double penalty{0};
+        uint32_t iterations{0};
+        uint32_t bestIter{0};
+        double seconds{0};
+    };
+
+    //! Runs many independent anneals of the same problem at once and keeps
+    //! the best result.
+
+    /*! Every run gets its own Annealer, copied from the same starting solution,
+        so they all share a single instance of the (immutable) world rather
+        than each holding a copy of it.  The runs are spread over a ThreadPool.
+
+        Run i is seeded with the i-th output of a SplitMix64 generator seeded
+        with the seed passed to solve(), so a given seed and run count always
+        produce the same result no matter how many threads do the work.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class PenaltyFunc, class SolutionType, class Engine = std::mt19937_64>
+    class MultiStart {
+    public:
+        typedef Annealer<PenaltyFunc, SolutionType, Engine> AnnealerType;
+
+        /*! Takes the same parameters as an Annealer; each run uses them all.
+
+        @param pfunc The penalty function to be applied to each run
+        @param sol The solution each run starts from
+        @param multT The temperature multiplier
+        @param accept Our initial willingness to accept an inferior solution
+        @param tBI The terminal best iteration
+        @param minIter The minimum number of annealing iterations to apply
+        @param maxIter The maximum number of annealing iterations to apply */
+        MultiStart(const PenaltyFunc &pfunc, const SolutionType &sol, double multT, double accept,
+                   uint32_t tBI, uint32_t minIter, uint32_t maxIter): _pfunc(pfunc),
+                                                                      _start(sol),
+                                                                      _multiplierT(multT),
+                                                                      _acceptProb(accept),
+                                                                      _terminalBestIter(tBI),
+                                                                      _minIterations(minIter),
+                                                                      _maxIterations(maxIter) {
+        }
+
+        virtual ~MultiStart() = default;
+
+        /*! Sets a time by which every run must stop; each then reports the best
+        solution it had found.  See Annealer::setDeadline().
+
+        @param deadline The time to stop by */
+        void setDeadline(const std::chrono::steady_clock::time_point deadline) { _deadline = deadline; }
+
+        /*! Sets a stop token which, once a stop is requested through it, stops
+        every run as the deadline would.
+
+        @param token The stop token to watch */
+        void setStopToken(std::stop_token token) { _stopToken = std::move(token); }
+
+        /*! Runs the anneals on an existing pool and waits for them all.  If
+        any run throws, the first exception is rethrown once every run has
+        finished.
+
+        @param runs The number of independent anneals
+        @param seed The seed from which every run's seed is derived
+        @param pool The pool to run on */
+        void solve(const uint32_t runs, const uint64_t seed, ThreadPool &pool) {
+            std::vector<std::future<std::shared_ptr<SolutionType> > > results;
+            SplitMix64 seeds(seed);
+            _statistics.assign(runs, RunStatistics{});
+            for (uint32_t run = 0; run < runs; run += 1) {
+                _statistics[run].run = run;
+                _statistics[run].seed = seeds();
+                results.push_back(pool.submit([this, run]() { return anneal(_statistics[run]); }));
+            }
+            _best.reset();
+            _bestRun = 0;
+            // Every run works on this driver's members, so wait for all of
+            // them, even after one has failed, before letting its exception out.
+            std::exception_ptr error;
+            for (uint32_t run = 0; run < runs; run += 1) {
+                std::shared_ptr<SolutionType> best;
+                try {
+                    best = results[run].get();
+                } catch (...) {
+                    if (!error)
+                        error = std::current_exception();
+                    continue;
+                }
+                if (!_best || best->getP() < _best->getP() ||
+                    (best->getP() == _best->getP() && best->getF() < _best->getF())) {
+                    _best = best;
+                    _bestRun = run;
+                }
+            }
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        /*! Runs the anneals on a pool of its own and waits for them all.
+
+        @param runs The number of independent anneals
+        @param seed The seed from which every run's seed is derived
+        @param threads The number of threads; 0 means one per hardware thread */
+        void solve(const uint32_t runs, const uint64_t seed, const uint32_t threads = 0) {
+            ThreadPool pool(threads);
+            solve(runs, seed, pool);
+        }
+
+        /*! Returns the best solution found by any run.  Only valid after
+            solve(). */
+        const SolutionType &best() const { return *_best; }
+
+        /*! Returns the index of the run which found the best solution. */
+        [[nodiscard]] uint32_t bestRun() const { return _bestRun; }
+
+        /*! Returns the cost of the best solution found by any run. */
+        [[nodiscard]] double cost() const { return _best->getF(); }
+
+        /*! Returns the penalty of the best solution found by any run. */
+        [[nodiscard]] double penalty() const { return _best->getP(); }
+
+        /*! Returns what happened during each run, in run order. */
+        [[nodiscard]] const std::vector<RunStatistics> &statistics() const { return _statistics; }
+
+        /*! Dumps the results of every run to an output stream as JSON.
+
+        @param os The output stream to dump it to
+        @return The output stream os after the operation completes */
+        std::ostream &dump(std::ostream &os) const {
+            os << "{\n\t\"best_run\":      " << _bestRun << ",\n\t"
+                    << "\"best_solution\": {\n\t\t\"base_cost\": "
+                    << (_best ? _best->getF() : 0) << ",\n\t\t\"penalty\":   "
+                    << (_best ? _best->getP() : 0) << "\n\t},\n\t\"runs\": [";
+            for (std::size_t i = 0; i < _statistics.size(); i += 1) {
+                const RunStatistics &stats = _statistics[i];
+                os << (i ? ",\n\t\t" : "\n\t\t")
+                        << "{\"run\": " << stats.run
+                        << ", \"seed\": " << stats.seed
+                        << ", \"base_cost\": " << stats.cost
+                        << ", \"penalty\": " << stats.penalty
+                        << ", \"iterations\": " << stats.iterations
+                        << ", \"best_iteration\": " << stats.bestIter
+                        << ", \"seconds\": " << stats.seconds << "}";
+            }
+            os << "\n\t]\n}\n";
+            return os;
+        }
+
+    protected:
+        PenaltyFunc _pfunc;
+        SolutionType _start;
+        double _multiplierT, _acceptProb;
+        uint32_t _terminalBestIter, _minIterations, _maxIterations;
+        std::chrono::steady_clock::time_point _deadline{std::chrono::steady_clock::time_point::max()};
+        std::stop_token _stopToken;
+        std::vector<RunStatistics> _statistics;
+        std::shared_ptr<SolutionType> _best;
+        uint32_t _bestRun{0};
+
+        /*! Runs a single anneal, filling in its statistics.
+
+        @param stats The run's statistics, with its seed already filled in
+        @return The best solution the run found */
+        std::shared_ptr<SolutionType> anneal(RunStatistics &stats) const {
+            const auto started = std::chrono::steady_clock::now();
+            PenaltyFunc pfunc(_pfunc);
+            SolutionType start(_start);
+            AnnealerType annealer(pfunc, start, _multiplierT, _acceptProb, _terminalBestIter,
+                                  _minIterations, _maxIterations);
+            annealer.seed(stats.seed);
+            annealer.setSampleThreads(1);
+            annealer.setDeadline(_deadline);
+            annealer.setStopToken(_stopToken);
+            annealer.solve();
+            stats.cost = annealer.cost();
+            stats.penalty = annealer.penalty();
+            stats.iterations = annealer.iterations();
+            stats.bestIter = annealer.bestIter();
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            return std::make_shared<SolutionType>(annealer.best());
+        }
+    };
+
+    //! Runs several Annealers side by side which periodically share their
+    //! best tours.
+
+    /*! Each island is an ordinary Annealer on its own thread.  Every
+        migrationInterval iterations the islands stop at a barrier and publish
+        their best solutions, each into a slot only it writes.  Once everyone
+        has arrived, the best of those becomes the global best.  Islands in
+        the worst restartFraction by best solution then restart their current
+        solution from it, so good structure found on one island spreads to the
+        others.  The island which holds the global best never restarts.
+
+        An island which meets its termination criteria publishes one last time
+        and drops out; the rest carry on until they finish too.
+
+        All exchanges happen at the barrier, and island i is seeded with the
+        i-th output of a SplitMix64 generator seeded by the caller.  So a given
+        seed always gives the same result, however the threads are scheduled.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class PenaltyFunc, class SolutionType, class Engine = std::mt19937_64>
+    class IslandModel {
+    public:
+        typedef Annealer<PenaltyFunc, SolutionType, Engine> AnnealerType;
+
+        /*! Takes the same parameters as an Annealer; each island uses them all.
+        Islands migrate every 10 iterations, and the worse half restart.
+
+        @param pfunc The penalty function to be applied to each island
+        @param sol The solution each island starts from
+        @param multT The temperature multiplier
+        @param accept Our initial willingness to accept an inferior solution
+        @param tBI The terminal best iteration
+        @param minIter The minimum number of annealing iterations to apply
+        @param maxIter The maximum number of annealing iterations to apply */
+        IslandModel(const PenaltyFunc &pfunc, const SolutionType &sol, double multT, double accept,
+                    uint32_t tBI, uint32_t minIter, uint32_t maxIter): _pfunc(pfunc),
+                                                                       _start(sol),
+                                                                       _multiplierT(multT),
+                                                                       _acceptProb(accept),
+                                                                       _terminalBestIter(tBI),
+                                                                       _minIterations(minIter),
+                                                                       _maxIterations(maxIter) {
+        }
+
+        virtual ~IslandModel() = default;
+
+        /*! Sets how the islands share their results.
+
+        @param interval The number of iterations between migrations
+        @param restartFraction The fraction of islands, worst first, which
+        restart from the global best at each migration */
+        void setMigration(const uint32_t interval, const double restartFraction) {
+            _migrationInterval = std::max<uint32_t>(1, interval);
+            _restartFraction = restartFraction;
+        }
+
+        /*! Sets a time by which every island must stop; each then reports the best
+        solution it had found.  See Annealer::setDeadline().
+
+        @param deadline The time to stop by */
+        void setDeadline(const std::chrono::steady_clock::time_point deadline) { _deadline = deadline; }
+
+        /*! Sets a stop token which, once a stop is requested through it, stops
+        every island as the deadline would.
+
+        @param token The stop token to watch */
+        void setStopToken(std::stop_token token) { _stopToken = std::move(token); }
+
+        /*! Runs the islands to termination.
+
+        @param islands The number of islands, each with its own thread
+        @param seed The seed from which every island's seed is derived */
+        void solve(const uint32_t islands, const uint64_t seed) {
+            SplitMix64 seeds(seed);
+            _islands.clear();
+            _slots.clear();
+            _statistics.assign(islands, RunStatistics{});
+            _restart.assign(islands, 0);
+            _migrations = 0;
+            _bestIsland = 0;
+            _globalBest = std::make_shared<SolutionType>(_start);
+            for (uint32_t i = 0; i < islands; i += 1) {
+                PenaltyFunc pfunc(_pfunc);
+                SolutionType start(_start);
+                _islands.push_back(std::make_unique<AnnealerType>(pfunc, start, _multiplierT, _acceptProb,
+                                                                  _terminalBestIter, _minIterations,
+                                                                  _maxIterations));
+                _statistics[i].run = i;
+                _statistics[i].seed = seeds();
+                _islands[i]->seed(_statistics[i].seed);
+                _islands[i]->setSampleThreads(1);
+                _islands[i]->setDeadline(_deadline);
+                _islands[i]->setStopToken(_stopToken);
+                _slots.push_back(std::make_shared<SolutionType>(_start));
+            }
+
+            std::exception_ptr error;
+            std::mutex errorLock;
+            std::barrier migration(islands, [this]() noexcept { migrate(); });
+            {
+                std::vector<std::jthread> threads;
+                for (uint32_t i = 0; i < islands; i += 1)
+                    threads.emplace_back([this, i, &migration, &error, &errorLock]() {
+                        try {
+                            run(i, migration);
+                        } catch (...) {
+                            std::scoped_lock lock(errorLock);
+                            if (!error)
+                                error = std::current_exception();
+                            migration.arrive_and_drop();
+                        }
+                    });
+            }
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        /*! Returns the best solution found by any island.  Only valid after
+            solve(). */
+        const SolutionType &best() const { return *_globalBest; }
+
+        /*! Returns the index of the island which found the best solution. */
+        [[nodiscard]] uint32_t bestIsland() const { return _bestIsland; }
+
+        /*! Returns the cost of the best solution found by any island. */
+        [[nodiscard]] double cost() const { return _globalBest->getF(); }
+
+        /*! Returns the penalty of the best solution found by any island. */
+        [[nodiscard]] double penalty() const { return _globalBest->getP(); }
+
+        /*! Returns the number of migrations which took place. */
+        [[nodiscard]] uint32_t migrations() const { return _migrations; }
+
+        /*! Returns what happened on each island, in island order. */
+        [[nodiscard]] const std::vector<RunStatistics> &statistics() const { return _statistics; }
+
+        /*! Dumps the results of every island to an output stream as JSON.
+
+        @param os The output stream to dump it to
+        @return The output stream os after the operation completes */
+        std::ostream &dump(std::ostream &os) const {
+            os << "{\n\t\"best_island\":   " << _bestIsland << ",\n\t"
+                    << "\"migrations\":    " << _migrations << ",\n\t"
+                    << "\"best_solution\": {\n\t\t\"base_cost\": "
+                    << (_globalBest ? _globalBest->getF() : 0) << ",\n\t\t\"penalty\":   "
+                    << (_globalBest ? _globalBest->getP() : 0) << "\n\t},\n\t\"islands\": [";
+            for (std::size_t i = 0; i < _statistics.size(); i += 1) {
+                const RunStatistics &stats = _statistics[i];
+                os << (i ? ",\n\t\t" : "\n\t\t")
+                        << "{\"island\": " << stats.run
+                        << ", \"seed\": " << stats.seed
+                        << ", \"base_cost\": " << stats.cost
+                        << ", \"penalty\": " << stats.penalty
+                        << ", \"iterations\": " << stats.iterations
+                        << ", \"best_iteration\": " << stats.bestIter
+                        << ", \"seconds\": " << stats.seconds << "}";
+            }
+            os << "\n\t]\n}\n";
+            return os;
+        }
+
+    protected:
+        PenaltyFunc _pfunc;
+        SolutionType _start;
+        double _multiplierT, _acceptProb;
+        uint32_t _terminalBestIter, _minIterations, _maxIterations;
+        std::chrono::steady_clock::time_point _deadline{std::chrono::steady_clock::time_point::max()};
+        std::stop_token _stopToken;
+        uint32_t _migrationInterval{10};
+        double _restartFraction{0.5};
+        std::vector<std::unique_ptr<AnnealerType> > _islands;
+        std::vector<std::shared_ptr<SolutionType> > _slots;
+        std::vector<char> _restart;
+        std::vector<RunStatistics> _statistics;
+        std::shared_ptr<SolutionType> _globalBest;
+        uint32_t _bestIsland{0};
+        uint32_t _migrations{0};
+
+        static bool better(const SolutionType &a, const SolutionType &b) {
+            return a.getP() < b.getP() || (a.getP() == b.getP() && a.getF() < b.getF());
+        }
+
+        /*! The body of island i's thread. */
+        template<class Barrier>
+        void run(const uint32_t i, Barrier &migration) {
+            const auto started = std::chrono::steady_clock::now();
+            AnnealerType &annealer = *_islands[i];
+            annealer.start();
+            while (true) {
+                for (uint32_t k = 0; k < _migrationInterval && !annealer.finished(); k += 1)
+                    annealer.step();
+                *_slots[i] = annealer.best();
+                RunStatistics &stats = _statistics[i];
+                stats.cost = annealer.cost();
+                stats.penalty = annealer.penalty();
+                stats.iterations = annealer.iterations();
+                stats.bestIter = annealer.bestIter();
+                stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+                if (annealer.finished()) {
+                    _restart[i] = 0;
+                    migration.arrive_and_drop();
+                    return;
+                }
+                migration.arrive_and_wait();
+                if (_restart[i])
+                    annealer.restartFrom(*_globalBest);
+            }
+        }
+
+        /*! Runs once per migration, after every island has published and
+            before any of them carries on. */
+        void migrate() {
+            const auto islands = static_cast<uint32_t>(_slots.size());
+            std::vector<uint32_t> order(islands);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [this](const uint32_t a, const uint32_t b) {
+                return better(*_slots[a], *_slots[b]);
+            });
+            if (0 == _migrations || better(*_slots[order[0]], *_globalBest)) {
+                *_globalBest = *_slots[order[0]];
+                _bestIsland = order[0];
+            }
+            const auto restarts = static_cast<uint32_t>(_restartFraction * islands);
+            std::fill(_restart.begin(), _restart.end(), 0);
+            for (uint32_t n = islands - std::min(restarts, islands); n < islands; n += 1)
+                if (order[n] != _bestIsland)
+                    _restart[order[n]] = 1;
+            ++_migrations;
+        }
+    };
+
+    /*! An operator<< which serves as a proxy for an IslandModel's dump() method.
+
+        @param os The output stream to write to
+        @param driver The IslandModel to be written
+        @return The output stream after the IslandModel is written */
+    template<class PenaltyFunc, class SolutionType, class Engine>
+    std::ostream &operator<<(std::ostream &os, const IslandModel<PenaltyFunc, SolutionType, Engine> &driver) {
+        return driver.dump(os);
+    }
+
+    /*! An operator<< which serves as a proxy for a MultiStart's dump() method.
+
+        @param os The output stream to write to
+        @param driver The MultiStart to be written
+        @return The output stream after the MultiStart is written */
+    template<class PenaltyFunc, class SolutionType, class Engine>
+    std::ostream &operator<<(std::ostream &os, const MultiStart<PenaltyFunc, SolutionType, Engine> &driver) {
+        return driver.dump(os);
+    }
+}
+
+
+#endif
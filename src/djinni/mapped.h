@@ -0,0 +1,158 @@
+/* Copyright (c) 2004 - 2025, Robert J. Hansen <rjh@sixdemonbag.org>
+ * and Tristan D. Thiede (address currently unknown).
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose with or without fee is hereby granted, provided
+ * that the above copyright notice and this permission notice appear
+ * in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE. */
+
+#ifndef MAPPED_H
+#define MAPPED_H
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#define DJINNI_MAPPED_WIN32
+#elif __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DJINNI_MAPPED_POSIX
+#endif
+
+
+namespace edu::uiowa::tippie::djinni {
+    //! A read-only view of an entire file, memory-mapped where the
+    //! platform allows it.
+
+    /*! On POSIX systems this uses mmap(2) and on Windows a file mapping
+        object.  Anywhere else the file is simply read into memory, so
+        callers never need to care which one they got.
+
+        A file which can't be opened yields an empty view; check isOpen()
+        if you need to tell the difference between that and an empty file.
+
+        @author Hansen
+        @since 2.5
+    */
+    class MappedFile {
+    public:
+        /*! Maps the named file.
+
+        @param filename The file to map */
+        explicit MappedFile(const std::string &filename) {
+#if defined(DJINNI_MAPPED_POSIX)
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+                return;
+            struct stat sb{};
+            if (0 == ::fstat(fd, &sb)) {
+                _open = true;
+                _size = static_cast<std::size_t>(sb.st_size);
+                if (_size > 0) {
+                    void *addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (MAP_FAILED == addr) {
+                        _open = false;
+                        _size = 0;
+                    } else {
+                        _data = static_cast<const char *>(addr);
+#ifdef MADV_SEQUENTIAL
+                        ::madvise(addr, _size, MADV_SEQUENTIAL);
+#endif
+                    }
+                }
+            }
+            ::close(fd);
+#elif defined(DJINNI_MAPPED_WIN32)
+            HANDLE file = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (INVALID_HANDLE_VALUE == file)
+                return;
+            LARGE_INTEGER size{};
+            if (::GetFileSizeEx(file, &size)) {
+                _open = true;
+                _size = static_cast<std::size_t>(size.QuadPart);
+                if (_size > 0) {
+                    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (nullptr != mapping) {
+                        _data = static_cast<const char *>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                        ::CloseHandle(mapping);
+                    }
+                    if (nullptr == _data) {
+                        _open = false;
+                        _size = 0;
+                    }
+                }
+            }
+            ::CloseHandle(file);
+#else
+            std::ifstream in(filename, std::ios::binary);
+            if (!in)
+                return;
+            _open = true;
+            _buffer.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+            _data = _buffer.data();
+            _size = _buffer.size();
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /*! Unmaps the file. */
+        ~MappedFile() {
+#if defined(DJINNI_MAPPED_POSIX)
+            if (nullptr != _data)
+                ::munmap(const_cast<char *>(_data), _size);
+#elif defined(DJINNI_MAPPED_WIN32)
+            if (nullptr != _data)
+                ::UnmapViewOfFile(_data);
+#endif
+        }
+
+        //! Returns true if the file was successfully opened.
+        [[nodiscard]] bool isOpen() const { return _open; }
+
+        //! Returns the file's contents.
+        [[nodiscard]] std::string_view view() const { return {_data, _size}; }
+
+        //! Returns a pointer to the first byte of the file.
+        [[nodiscard]] const char *data() const { return _data; }
+
+        //! Returns the size of the file in bytes.
+        [[nodiscard]] std::size_t size() const { return _size; }
+
+    private:
+        const char *_data{nullptr};
+        std::size_t _size{0};
+        bool _open{false};
+#if !defined(DJINNI_MAPPED_POSIX) && !defined(DJINNI_MAPPED_WIN32)
+        std::string _buffer;
+#endif
+    };
+}
+
+
+#endif
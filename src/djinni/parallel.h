@@ -0,0 +1,236 @@
+/* Copyright (c) 2004 - 2025, Robert J. Hansen <rjh@sixdemonbag.org>
+ * and Tristan D. Thiede (address currently unknown).
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose with or without fee is hereby granted, provided
+ * that the above copyright notice and this permission notice appear
+ * in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE. */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace edu::uiowa::tippie::djinni {
+    /*! Returns the number of hardware threads available, or 1 if the
+        platform won't tell us.
+
+        @author Hansen
+        @since 2.5
+    */
+    inline uint32_t hardwareThreads() {
+        const uint32_t n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    /*! Calls fn(i) for every i in [begin, end), spreading the calls across
+        up to the given number of threads.  Indices are handed out one at a
+        time in increasing order, so uneven workloads balance themselves.
+
+        The calling thread does its share of the work.  If any call throws,
+        the remaining indices are abandoned and the first exception is
+        rethrown once every thread has finished.
+
+        @param begin The first index
+        @param end One past the last index
+        @param fn The function to call for each index
+        @param threads The maximum number of threads to use; 0 means one per
+        hardware thread
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class Function>
+    void parallelFor(const uint32_t begin, const uint32_t end, Function fn, uint32_t threads = 0) {
+        if (begin >= end)
+            return;
+        if (0 == threads)
+            threads = hardwareThreads();
+        threads = std::min(threads, end - begin);
+        if (threads <= 1) {
+            for (uint32_t i = begin; i < end; i += 1)
+                fn(i);
+            return;
+        }
+
+        std::atomic<uint32_t> next{begin};
+        std::exception_ptr error;
+        std::mutex errorLock;
+        auto worker = [&]() {
+            try {
+                for (uint32_t i = next++; i < end; i = next++)
+                    fn(i);
+            } catch (...) {
+                next = end;
+                std::scoped_lock lock(errorLock);
+                if (!error)
+                    error = std::current_exception();
+            }
+        };
+        {
+            std::vector<std::jthread> pool;
+            pool.reserve(threads - 1);
+            for (uint32_t t = 1; t < threads; t += 1)
+                pool.emplace_back(worker);
+            worker();
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    //! A fixed-size, work-stealing pool of threads.
+
+    /*! Every worker owns a queue.  Tasks submitted from outside the pool are
+        dealt out to the queues round-robin; tasks submitted by a worker go
+        onto its own queue.  A worker takes from the front of its own queue
+        and, when that runs dry, steals from the back of everyone else's.
+
+        Destroying the pool waits for every task already submitted to finish.
+
+        @author Hansen
+        @since 2.5
+    */
+    class ThreadPool {
+    public:
+        /*! Starts the pool.
+
+        @param threads The number of worker threads; 0 means one per hardware
+        thread */
+        explicit ThreadPool(uint32_t threads = 0) {
+            if (0 == threads)
+                threads = hardwareThreads();
+            for (uint32_t i = 0; i < threads; i += 1)
+                _queues.push_back(std::make_unique<Queue>());
+            for (uint32_t i = 0; i < threads; i += 1)
+                _workers.emplace_back([this, i]() { work(i); });
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /*! Finishes all submitted work, then stops the workers. */
+        ~ThreadPool() {
+            {
+                std::scoped_lock lock(_sleepLock);
+                _stopping = true;
+            }
+            _wake.notify_all();
+            _workers.clear();
+        }
+
+        /*! Queues a task.
+
+        @param task A callable taking no arguments
+        @return A future which receives the task's result, or its exception */
+        template<class Task>
+        std::future<std::invoke_result_t<std::decay_t<Task> > > submit(Task &&task) {
+            typedef std::invoke_result_t<std::decay_t<Task> > Result;
+            std::packaged_task<Result()> packaged(std::forward<Task>(task));
+            std::future<Result> result = packaged.get_future();
+            const uint32_t index = (this == _owner)
+                                       ? _ownerIndex
+                                       : _nextQueue.fetch_add(1, std::memory_order_relaxed) % size();
+            {
+                std::scoped_lock lock(_queues[index]->lock);
+                _queues[index]->tasks.emplace_back(std::move(packaged));
+            }
+            {
+                std::scoped_lock lock(_sleepLock);
+                _pending += 1;
+            }
+            _wake.notify_one();
+            return result;
+        }
+
+        /*! Returns the number of worker threads. */
+        [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(_queues.size()); }
+
+    private:
+        typedef std::move_only_function<void()> Task;
+
+        struct Queue {
+            std::mutex lock;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue> > _queues;
+        std::mutex _sleepLock;
+        std::condition_variable _wake;
+        uint64_t _pending{0};
+        bool _stopping{false};
+        std::atomic<uint32_t> _nextQueue{0};
+        std::vector<std::jthread> _workers;
+
+        inline static thread_local const ThreadPool *_owner{nullptr};
+        inline static thread_local uint32_t _ownerIndex{0};
+
+        bool take(const uint32_t index, Task &task) {
+            for (uint32_t n = 0; n < size(); n += 1) {
+                Queue &queue = *_queues[(index + n) % size()];
+                std::scoped_lock lock(queue.lock);
+                if (queue.tasks.empty())
+                    continue;
+                if (0 == n) {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                } else {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+                return true;
+            }
+            return false;
+        }
+
+        void work(const uint32_t index) {
+            _owner = this;
+            _ownerIndex = index;
+            Task task;
+            while (true) {
+                {
+                    std::unique_lock lock(_sleepLock);
+                    _wake.wait(lock, [this]() { return _pending > 0 || _stopping; });
+                    if (0 == _pending)
+                        return;
+                }
+                if (take(index, task)) {
+                    {
+                        std::scoped_lock lock(_sleepLock);
+                        _pending -= 1;
+                    }
+                    task();
+                    task = nullptr;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+}
+
+
+#endif
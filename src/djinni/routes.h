@@ -1,526 +1,2092 @@
-/* Copyright (c) 2004 - 2025, Robert J. Hansen <rjh@sixdemonbag.org>
- * and Tristan D. Thiede (address currently unknown).
- *
- * Permission to use, copy, modify, and/or distribute this software
- * for any purpose with or without fee is hereby granted, provided
- * that the above copyright notice and this permission notice appear
- * in all copies.
- *
- * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
- * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
- * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
- * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
- * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
- * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
- * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
- * PERFORMANCE OF THIS SOFTWARE. */
-
-
-#ifndef ROUTES_H
-#define ROUTES_H
-
-#include <algorithm>
-#include <cmath>
-#include <fstream>
-#include <iterator>
-#include <memory>
-#include <regex>
-#include <cstdint>
-#include <string>
-#include <vector>
-
-
-namespace edu::uiowa::tippie::djinni {
-    //! A recursive templatized structure representing a matrix of arbitrary
-    //! dimensionality.
-
-    /*! Originally we had our own Matrix class to provide arbitrary dimensions,
-        but implemented it via runtime checks and nonrecursive structures.  As
-        it turns out this was precisely the wrong thing to do.  Switching to a
-        recursive template resulted in immense performance improvements.
-
-        @author Hansen
-        @since 2.2.2
-    */
-    template<typename T, const int N>
-    class Matrix {
-    public:
-        typedef T value_type;
-
-        Matrix() = default;
-
-        explicit Matrix(const std::vector<Matrix<T, N - 1> > &matrix)
-            : _matrix(matrix) {
-        }
-#ifdef USE_BOUNDS_CHECKING
-    const Matrix<T, N - 1>& operator[](const uint32_t n) const
-    {
-        return _matrix.at(n);
-    }
-    Matrix<T, N - 1>& operator[](const uint32_t n) { return _matrix.at(n); }
-#else
-        const Matrix<T, N - 1> &operator[](const uint32_t n) const {
-            return _matrix[n];
-        }
-
-        Matrix<T, N - 1> &operator[](const uint32_t n) { return _matrix[n]; }
-#endif
-        static uint32_t dimensions() { return Matrix<T, N>::DIMENSIONS; }
-
-        void reset() {
-            for (uint32_t i = 0; i < _matrix.size(); i += 1)
-                _matrix[i].reset();
-        }
-
-        [[nodiscard]] uint32_t size() const { return _matrix.size(); }
-        void push_back(const Matrix<T, N - 1> &matrix) { _matrix.push_back(matrix); }
-        void resize(const uint32_t n) { _matrix.resize(n, Matrix<T, N - 1>()); }
-
-    protected:
-        static const uint32_t DIMENSIONS = N;
-        std::vector<Matrix<T, N - 1> > _matrix;
-    };
-
-    //! A recursive templatized structure representing a one-dimensional matrix.
-
-    /*! Originally we had our own Matrix class to provide arbitrary dimensions,
-        but implemented it via runtime checks and nonrecursive structures.  As
-        it turns out this was precisely the wrong thing to do.  Switching to a
-        recursive template resulted in immense performance improvements.
-
-        @author Hansen
-        @since 2.2.2
-    */
-    template<typename T>
-    class Matrix<T, 1> {
-    public:
-        typedef T value_type;
-
-        Matrix()
-            : _matrix() {
-        }
-
-        explicit Matrix(const std::vector<T> &vec)
-            : _matrix(vec) {
-        }
-#ifdef USE_BOUNDS_CHECKING
-    const T& operator[](const uint32_t n) const { return _matrix.at(n); }
-    T& operator[](const uint32_t n) { return _matrix.at(n); }
-#else
-        const T &operator[](const uint32_t n) const { return _matrix[n]; }
-        T &operator[](const uint32_t n) { return _matrix[n]; }
-#endif
-        static uint32_t dimensions() { return Matrix<T, 1>::DIMENSIONS; }
-        void reset() { _matrix.clear(); }
-        [[nodiscard]] uint32_t size() const { return _matrix.size(); }
-        void push_back(const std::vector<T> &vec) { _matrix.push_back(vec); }
-        void resize(const uint32_t n) { _matrix.resize(n, T()); }
-
-    protected:
-        std::vector<T> _matrix;
-        static constexpr uint32_t DIMENSIONS = 1;
-    };
-
-    //! A class representing an instance of the Traveling Salesman Problem with Time
-    //! Windows.
-
-    /*! @author Hansen, Ohlmann, Thomas
-        @since 1.0
-    */
-    class TravelingSalesmanWorld {
-    public:
-        TravelingSalesmanWorld() = default;
-
-        static TravelingSalesmanWorld loadFromDumasFile(std::string filename) {
-            std::ifstream in(filename);
-            std::string str(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
-            return loadFromDumasString(str);
-        };
-
-        static TravelingSalesmanWorld loadFromDumasString(std::string dumasStr) {
-            TravelingSalesmanWorld tsp;
-            std::smatch match;
-            size_t pos = 0;
-            static std::regex drx("^\\s*(\\d+)"
-                "(\\s+[+-]?[0-9]*[.]?[0-9]+)"
-                "(\\s+[+-]?[0-9]*[.]?[0-9]+)"
-                "(\\s+[+-]?[0-9]*[.]?[0-9]+)"
-                "(\\s+[+-]?[0-9]*[.]?[0-9]+)"
-                "(\\s+[+-]?[0-9]*[.]?[0-9]+)"
-                "(\\s+[+-]?[0-9]*[.]?[0-9]+)"
-                "\\s*$");
-            while ((pos = dumasStr.find('\n')) != std::string::npos) {
-                std::string line = dumasStr.substr(0, pos);
-                if (std::regex_match(line, match, drx)) {
-                    if (999 == std::stoi(match[1].str()))
-                        break;
-                    std::vector<double> row(6);
-                    for (uint32_t i = 0; i < 6; i += 1)
-                        row[i] = std::stod(match[i + 2].str());
-                    tsp.data().push_back(Matrix<double, 1>(row));
-                }
-                dumasStr.erase(0, pos + 1);
-            }
-            tsp.computeTravelTimes();
-            return tsp;
-        };
-
-        virtual ~TravelingSalesmanWorld() = default;
-
-        [[nodiscard]] const Matrix<double, 2> &travelTimes() const { return _timeMatrix; }
-        [[nodiscard]] const std::vector<double> &lowDeadlines() const { return _lowdeadlines; }
-        [[nodiscard]] const std::vector<double> &deadlines() const { return _deadlines; }
-
-        //! Returns a const-reference to the Matrix used to store this world's data.
-        [[nodiscard]] const Matrix<double, 2> &data() const { return _matrix; }
-
-        //! Returns a reference to the Matrix used to store this world's data.
-        [[nodiscard]] Matrix<double, 2> &data() { return _matrix; }
-
-        //! Returns a const reference to the identifying string used for this World.
-        [[nodiscard]] const std::string &identifier() const { return _identifier; }
-
-    protected:
-        Matrix<double, 2> _timeMatrix;
-        Matrix<double, 2> _matrix;
-        std::vector<double> _lowdeadlines, _deadlines;
-        std::string _identifier;
-
-        virtual void computeTravelTimes() {
-            uint32_t numCustomers = _matrix.size();
-            _timeMatrix.resize(numCustomers);
-            for (uint32_t i = 0; i < numCustomers; i++) {
-                _timeMatrix[i].resize(numCustomers);
-                for (uint32_t j = 0; j < numCustomers; j++) {
-                    _timeMatrix[i][j] = ::sqrt(
-                        (_matrix[i][0] - _matrix[j][0]) * (_matrix[i][0] - _matrix[j][0]) + (
-                            _matrix[i][1] - _matrix[j][1])
-                        * (_matrix[i][1] - _matrix[j][1]));
-                    _timeMatrix[i][j] = ::floor(_timeMatrix[i][j]);
-                }
-            }
-            for (uint32_t i = 0; i < numCustomers; i++)
-                for (uint32_t j = 0; j < numCustomers; j++)
-                    for (uint32_t k = 0; k < numCustomers; k++)
-                        if (_timeMatrix[i][j] > (_timeMatrix[i][k] + _timeMatrix[k][j]))
-                            _timeMatrix[i][j] = _timeMatrix[i][k] + _timeMatrix[k][j];
-            _lowdeadlines.resize(numCustomers);
-            _deadlines.resize(numCustomers);
-            for (uint32_t i = 0; i <= numCustomers - 1; i++) {
-#ifdef USE_BOUNDS_CHECKING
-            _lowdeadlines.at(i) = _matrix[i][3];
-            _deadlines.at(i) = _matrix[i][4];
-#else
-                _lowdeadlines[i] = _matrix[i][3];
-                _deadlines[i] = _matrix[i][4];
-#endif
-            }
-        }
-    };
-
-    //! A representation of information needed for the Traveling Salesman Problem.
-    /*! While many different WorldTypes can be used with TravelingSalesmanSolution, it has been most
-        thoroughly tested with TravelingSalesmanWorld.  Attempting to use other world types may
-        shake loose some interesting bugs.  Or they might not and our code could
-        be perfect.  We don't know.  Don't panic, and have fun.
-
-        @author Hansen, Thiede
-        @since 2.0
-    */
-    template<class WorldType>
-    class TravelingSalesmanSolution {
-    public:
-        /*! A constructor that uses an already initialized World object.
-        @param w A WorldType object */
-        explicit TravelingSalesmanSolution(const WorldType &w)
-            : _w(new WorldType(w)),
-              _f{0.0},
-              _p{0.0},
-              _time{0.0},
-              _cost{0.0},
-              _timeWait{0.0},
-              _firstswitch{0},
-              _secondswitch{0},
-              _firstarrival{0},
-              _firstpenalty{0} {
-            _solution.resize(_w->data().size(), 0);
-            _arrivaltime.resize(_solution.size(), 0);
-            _penaltysum.resize(_solution.size(), 0);
-            _identifier = "TravelingSalesmanSolution";
-        }
-
-        /*! A constructor that initializes a new WorldType.
-
-        @param worldParam A char* containing parameters used to initialize a new
-        object of type WorldType */
-        explicit TravelingSalesmanSolution(const char *worldParam)
-            : _w(new WorldType{}),
-              _f{0.0},
-              _p{0.0},
-              _time{0.0},
-              _cost{0.0},
-              _timeWait{0.0},
-              _firstswitch{0},
-              _secondswitch{0},
-              _firstarrival{0},
-              _firstpenalty{0} {
-            *_w = WorldType::loadFromDumasFile();
-            _solution.resize(_w->data().size(), 0);
-            _arrivaltime.resize(_solution.size(), 0);
-            _penaltysum.resize(_solution.size(), 0);
-            _identifier = "TravelingSalesmanSolution";
-        }
-
-        /*! Virtualized for the benefit of future subclassing. */
-        virtual ~TravelingSalesmanSolution() = default;
-
-        /*! Sets the Feasible component of the solution
-        @param f The new feasible component */
-        void setF(const double &f) { _f = f; }
-
-        /*! Sets the Penalty component of the solution
-        @param p The new penalty component */
-        void setP(const double &p) { _p = p; }
-
-        /*! Returns the Feasible component of the solution
-        @return The feasible component of the current solution */
-        [[nodiscard]] double getF() const { return _f; }
-
-        /*! Returns the Penalty component of the solution
-        @return the Penalty component of the current solution */
-        [[nodiscard]] double getP() const { return _p; }
-
-        /*! Generates a neighbor TravelingSalesmanSolution from this current TravelingSalesmanSolution.
-        @param neighbor The TravelingSalesmanSolution object which will receive the value.*/
-        void generateNeighbor(TravelingSalesmanSolution &neighbor) {
-            uint32_t firstswitch = 0;
-            uint32_t numCustomers = _solution.size();
-            neighbor.setF(getF());
-            neighbor.setP(getP());
-            while (0 == firstswitch)
-                firstswitch = static_cast<int>((numCustomers - 1) *
-                                               TravelingSalesmanSolution::dis(
-                                                   TravelingSalesmanSolution::prng)) + 1;
-            uint32_t secondswitch = firstswitch;
-            while ((secondswitch == firstswitch) || (secondswitch == firstswitch - 1))
-                secondswitch = static_cast<int>((numCustomers - 1) *
-                                                TravelingSalesmanSolution::dis(
-                                                    TravelingSalesmanSolution::prng)) + 1;
-            int holder = _solution[firstswitch];
-            if (firstswitch < secondswitch) {
-                std::copy(_solution.begin(), _solution.begin() + firstswitch,
-                          neighbor._solution.begin());
-                std::copy(_solution.begin() + firstswitch + 1,
-                          _solution.begin() + secondswitch + 1,
-                          neighbor._solution.begin() + firstswitch);
-                neighbor._solution[secondswitch] = holder;
-                neighbor._firstarrival = static_cast<uint32_t>(_arrivaltime[firstswitch - 1]);
-                neighbor._firstpenalty = static_cast<uint32_t>(_penaltysum[firstswitch - 1]);
-                std::copy(_arrivaltime.begin(), _arrivaltime.begin() + firstswitch,
-                          neighbor._arrivaltime.begin());
-                std::copy(_penaltysum.begin(), _penaltysum.begin() + firstswitch,
-                          neighbor._penaltysum.begin());
-            } else {
-                std::copy(_solution.begin(), _solution.begin() + secondswitch + 1,
-                          neighbor._solution.begin());
-                std::copy(_solution.begin() + secondswitch + 1,
-                          _solution.begin() + firstswitch,
-                          neighbor._solution.begin() + secondswitch + 2);
-                neighbor._solution[secondswitch + 1] = holder;
-                neighbor._firstarrival = static_cast<uint32_t>(_arrivaltime[secondswitch]);
-                neighbor._firstpenalty = static_cast<uint32_t>(_penaltysum[secondswitch]);
-                std::copy(_arrivaltime.begin(), _arrivaltime.begin() + secondswitch + 1,
-                          neighbor._arrivaltime.begin());
-                std::copy(_penaltysum.begin(), _penaltysum.begin() + secondswitch + 1,
-                          neighbor._penaltysum.begin());
-            }
-            if (std::max(firstswitch, secondswitch) != numCustomers)
-                std::copy(_solution.begin() + std::max(firstswitch, secondswitch) + 1,
-                          _solution.end(),
-                          neighbor._solution.begin() + std::max(firstswitch, secondswitch) + 1);
-            neighbor._firstswitch = firstswitch;
-            neighbor._secondswitch = secondswitch;
-            neighbor.update();
-        }
-
-        /*! Update schedules, member data, etc., based on current state. */
-        void update() {
-            double cost = getF();
-            int firstswitch = _firstswitch;
-            int secondswitch = _secondswitch;
-            int numCustomers = _solution.size();
-            const std::vector<int> &tour = _solution;
-            const Matrix<double, 2> &travTime = _w->travelTimes();
-            if (firstswitch <= secondswitch) {
-                if (secondswitch != (numCustomers - 1)) {
-                    cost -= (travTime[tour[firstswitch - 1]][tour[secondswitch]] + travTime[tour[
-                                 secondswitch]][tour[
-                                 firstswitch]] + travTime[tour[secondswitch - 1]][tour[secondswitch + 1]]);
-                    cost += (travTime[tour[firstswitch - 1]][tour[firstswitch]] + travTime[tour[
-                                 secondswitch - 1]][tour[
-                                 secondswitch]] + travTime[tour[secondswitch]][tour[secondswitch + 1]]);
-                } else {
-                    cost -= (travTime[tour[firstswitch - 1]][tour[secondswitch]] + travTime[tour[
-                                 secondswitch]][tour[
-                                 firstswitch]] + travTime[tour[secondswitch - 1]][tour[0]]);
-                    cost += (travTime[tour[firstswitch - 1]][tour[firstswitch]] + travTime[tour[
-                                 secondswitch - 1]][tour[
-                                 secondswitch]] + travTime[tour[secondswitch]][tour[0]]);
-                }
-                timingUpdate();
-            } else {
-                if (firstswitch != (numCustomers - 1)) {
-                    cost -= (travTime[tour[secondswitch]][tour[secondswitch + 2]] + travTime[tour[
-                                 firstswitch]][tour[
-                                 secondswitch + 1]] + travTime[tour[secondswitch + 1]][tour[
-                                 firstswitch + 1]]);
-                    cost += (travTime[tour[firstswitch]][tour[firstswitch + 1]] + travTime[tour[
-                                 secondswitch]][tour[
-                                 secondswitch + 1]] + travTime[tour[secondswitch + 1]][tour[
-                                 secondswitch + 2]]);
-                } else {
-                    cost -= (travTime[tour[secondswitch]][tour[secondswitch + 2]] + travTime[tour[
-                                 firstswitch]][tour[
-                                 secondswitch + 1]] + travTime[tour[secondswitch + 1]][tour[0]]);
-                    cost += (travTime[tour[firstswitch]][tour[0]] + travTime[tour[secondswitch]][tour[
-                                 secondswitch + 1]] +
-                             travTime[tour[secondswitch + 1]][tour[secondswitch + 2]]);
-                }
-                timingUpdate();
-            }
-            setF(cost);
-            setP(_penaltysum[numCustomers - 1]);
-        }
-
-        /*! Randomize this TravelingSalesmanSolution. */
-        void randomize() {
-            for (uint32_t i = 0; i < _solution.size(); i += 1)
-                _solution[i] = static_cast<int>(i);
-            auto iter = _solution.begin();
-            ++iter;
-            std::shuffle(iter, _solution.end(), TravelingSalesmanSolution::prng);
-        }
-
-        /*! Copy constructor.
-        @param route The route to copy from. */
-        TravelingSalesmanSolution(const TravelingSalesmanSolution<WorldType> &route)
-            : _w(route._w)
-              , _solution(route._solution)
-              , _f(route._f)
-              , _p(route._p)
-              , _identifier(route._identifier)
-              , _arrivaltime(route._arrivaltime)
-              , _penaltysum(route._penaltysum)
-              , _time(route._time)
-              , _cost(route._cost)
-              , _timeWait(route._timeWait)
-              , _firstswitch(route._firstswitch)
-              , _secondswitch(route._secondswitch)
-              , _firstarrival(route._firstarrival)
-              , _firstpenalty(route._firstpenalty) {
-        }
-
-        /*! Dump our current path to an output stream.
-        @param os The output stream to dump our path to
-        @return The output stream after we've dumped in it */
-        std::ostream &dump(std::ostream &os) const {
-            std::ostream_iterator<int> oiter(os, " ");
-            std::ranges::copy(_solution, oiter);
-            return os;
-        }
-
-        /*! Computes the feasible and penalty portions of this TravelingSalesmanSolution. */
-        void compute() {
-            double addEnergy = 0;
-            double energy = 0;
-            double minutesMissed = 0;
-            double routeTime = 0;
-            double waitTime = 0;
-
-            const Matrix<double, 2> &travTime = _w->travelTimes();
-            const std::vector<double> &lowdeadlines = _w->lowDeadlines();
-            const std::vector<double> &deadlines = _w->deadlines();
-
-            _penaltysum[0] = 0;
-            _arrivaltime[0] = 0;
-
-            for (uint32_t i = 0; i < _solution.size() - 1; ++i) {
-                energy += travTime[_solution[i]][_solution[i + 1]];
-                routeTime += travTime[_solution[i]][_solution[i + 1]];
-                _arrivaltime[i + 1] = energy;
-                if (energy < lowdeadlines[_solution[i + 1]]) {
-                    addEnergy = lowdeadlines[_solution[i + 1]] - energy;
-                    waitTime += addEnergy;
-                    energy += addEnergy;
-                }
-                if (energy > deadlines[_solution[i + 1]])
-                    minutesMissed += energy - deadlines[_solution[i + 1]];
-                _penaltysum[i + 1] = minutesMissed;
-            }
-            //        energy += travTime[_solution[_solution.size() - 1]][_solution[0]];
-            routeTime += travTime[_solution[_solution.size() - 1]][_solution[0]];
-            setF(routeTime);
-            _time = routeTime;
-            setP(minutesMissed);
-            _timeWait = waitTime;
-        }
-
-    protected:
-        /*! Update the travel schedule. */
-        void timingUpdate() {
-            int start;
-            int numCustomers = _solution.size();
-            const Matrix<double, 2> &travTime = _w->travelTimes();
-            const std::vector<double> &lowdeadlines = _w->lowDeadlines();
-            const std::vector<double> &deadlines = _w->deadlines();
-            const std::vector<int> &tour = _solution;
-
-            if (_firstswitch < _secondswitch)
-                start = _firstswitch;
-            else
-                start = _secondswitch + 1;
-
-            _arrivaltime[start - 1] = _firstarrival;
-            _penaltysum[start - 1] = _firstpenalty;
-            for (int i = start; i <= numCustomers - 1; i++) {
-                if (_arrivaltime[i - 1] >= lowdeadlines[tour[i - 1]])
-                    _arrivaltime[i] = _arrivaltime[i - 1] + travTime[tour[i - 1]][tour[i]];
-                else
-                    _arrivaltime[i] = lowdeadlines[tour[i - 1]] + travTime[tour[i - 1]][tour[i]];
-                if (_arrivaltime[i] > deadlines[tour[i]])
-                    _penaltysum[i] = _penaltysum[i - 1] + (_arrivaltime[i] - deadlines[tour[i]]);
-                else
-                    _penaltysum[i] = _penaltysum[i - 1];
-            }
-        }
-
-        std::shared_ptr<WorldType> _w;
-        std::vector<int> _solution;
-        double _f, _p;
-        std::string _identifier;
-        std::vector<double> _arrivaltime;
-        std::vector<double> _penaltysum;
-        double _time, _cost, _timeWait;
-        uint32_t _firstswitch, _secondswitch, _firstarrival, _firstpenalty;
-        inline static std::random_device rd{};
-        inline static std::mt19937_64 prng{rd()};
-        inline static std::uniform_real_distribution<> dis{0.0, 1.0};
-    };
-
-    /*! An operator<< overloaded for TravelingSalesmanSolution.
-
-        @param os An output stream to write to
-        @param sol A TravelingSalesmanSolution to write
-        @return An output stream after we've written to it
-    */
-    template<class WorldType>
-    std::ostream &operator<<(std::ostream &os, const TravelingSalesmanSolution<WorldType> &sol) {
-        return sol.dump(os);
-    }
-
-    /*! A more human-readable version of a fully qualified typename. */
-    typedef TravelingSalesmanSolution<TravelingSalesmanWorld> TravelingSalesman;
-}
-
-
-#endif
+/* Copyright (c) 2004 - 2025, Robert J. Hansen <rjh@sixdemonbag.org>
+ * and Tristan D. Thiede (address currently unknown).
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose with or without fee is hereby granted, provided
+ * that the above copyright notice and this permission notice appear
+ * in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ * OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE. */
+
+
+#ifndef ROUTES_H
+#define ROUTES_H
+
+#include "mapped.h"
+#include "parallel.h"
+#include "random.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+
+namespace edu::uiowa::tippie::djinni {
+    //! The size, in bytes, of a cache line on every platform we care about.
+    constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    //! A standard-conforming allocator which hands out memory aligned to
+    //! a given boundary (by default, a cache line).
+
+    /*! @author Hansen
+        @since 2.5
+    */
+    template<typename T, std::size_t Alignment = CACHE_LINE_SIZE>
+    class AlignedAllocator {
+    public:
+        typedef T value_type;
+
+        template<typename U>
+        struct rebind {
+            typedef AlignedAllocator<U, Alignment> other;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {
+        }
+
+        T *allocate(const std::size_t n) {
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        void deallocate(T *p, std::size_t) noexcept {
+            ::operator delete(p, std::align_val_t{Alignment});
+        }
+
+        friend bool operator==(const AlignedAllocator &, const AlignedAllocator &) { return true; }
+    };
+
+    //! Storage tag selecting the classic vector-of-vectors Matrix layout.
+    struct NestedStorage {
+    };
+
+    //! Storage tag selecting a single contiguous, row-major Matrix layout.
+    struct DenseStorage {
+    };
+
+    //! Storage tag selecting a contiguous, row-major N-by-N Matrix whose
+    //! shape is fixed at compile time.
+    template<uint32_t N>
+    struct FixedStorage {
+    };
+
+    //! A recursive templatized structure representing a matrix of arbitrary
+    //! dimensionality.
+
+    /*! Originally we had our own Matrix class to provide arbitrary dimensions,
+        but implemented it via runtime checks and nonrecursive structures.  As
+        it turns out this was precisely the wrong thing to do.  Switching to a
+        recursive template resulted in immense performance improvements.
+
+        @author Hansen
+        @since 2.2.2
+    */
+    template<typename T, const int N, class Storage = NestedStorage>
+    class Matrix {
+    public:
+        typedef T value_type;
+
+        Matrix() = default;
+
+        explicit Matrix(const std::vector<Matrix<T, N - 1> > &matrix)
+            : _matrix(matrix) {
+        }
+#ifdef USE_BOUNDS_CHECKING
+    const Matrix<T, N - 1>& operator[](const uint32_t n) const
+    {
+        return _matrix.at(n);
+    }
+    Matrix<T, N - 1>& operator[](const uint32_t n) { return _matrix.at(n); }
+#else
+        const Matrix<T, N - 1> &operator[](const uint32_t n) const {
+            return _matrix[n];
+        }
+
+        Matrix<T, N - 1> &operator[](const uint32_t n) { return _matrix[n]; }
+#endif
+        static uint32_t dimensions() { return Matrix<T, N>::DIMENSIONS; }
+
+        void reset() {
+            for (uint32_t i = 0; i < _matrix.size(); i += 1)
+                _matrix[i].reset();
+        }
+
+        [[nodiscard]] uint32_t size() const { return _matrix.size(); }
+        void push_back(const Matrix<T, N - 1> &matrix) { _matrix.push_back(matrix); }
+        void resize(const uint32_t n) { _matrix.resize(n, Matrix<T, N - 1>()); }
+
+    protected:
+        static const uint32_t DIMENSIONS = N;
+        std::vector<Matrix<T, N - 1> > _matrix;
+    };
+
+    //! A recursive templatized structure representing a one-dimensional matrix.
+
+    /*! Originally we had our own Matrix class to provide arbitrary dimensions,
+        but implemented it via runtime checks and nonrecursive structures.  As
+        it turns out this was precisely the wrong thing to do.  Switching to a
+        recursive template resulted in immense performance improvements.
+
+        @author Hansen
+        @since 2.2.2
+    */
+    template<typename T>
+    class Matrix<T, 1> {
+    public:
+        typedef T value_type;
+
+        Matrix()
+            : _matrix() {
+        }
+
+        explicit Matrix(const std::vector<T> &vec)
+            : _matrix(vec) {
+        }
+#ifdef USE_BOUNDS_CHECKING
+    const T& operator[](const uint32_t n) const { return _matrix.at(n); }
+    T& operator[](const uint32_t n) { return _matrix.at(n); }
+#else
+        const T &operator[](const uint32_t n) const { return _matrix[n]; }
+        T &operator[](const uint32_t n) { return _matrix[n]; }
+#endif
+        static uint32_t dimensions() { return Matrix<T, 1>::DIMENSIONS; }
+        void reset() { _matrix.clear(); }
+        [[nodiscard]] uint32_t size() const { return _matrix.size(); }
+        void push_back(const std::vector<T> &vec) { _matrix.push_back(vec); }
+        void resize(const uint32_t n) { _matrix.resize(n, T()); }
+
+    protected:
+        std::vector<T> _matrix;
+        static constexpr uint32_t DIMENSIONS = 1;
+    };
+
+    //! A two-dimensional matrix kept in one contiguous, row-major,
+    //! cache-line-aligned block.
+
+    /*! The recursive Matrix costs two pointer chases per element lookup, and
+        each row lives in its own heap block.  For the travel-time tables
+        that sit in the innermost annealing loop that's a bad trade, so this
+        specialization keeps every element in a single allocation and hands
+        out lightweight row views so that m[i][j] still works.
+
+        If padding is requested, each row's stride is rounded up to a whole
+        number of cache lines, so every row begins on a cache line boundary.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<typename T>
+    class Matrix<T, 2, DenseStorage> {
+    public:
+        typedef T value_type;
+
+        //! A non-owning view of a single row of a dense Matrix.
+        template<typename U>
+        class Row {
+        public:
+            Row(U *row, const uint32_t n)
+                : _row(row), _n(n) {
+            }
+#ifdef USE_BOUNDS_CHECKING
+        U& operator[](const uint32_t n) const
+        {
+            if (n >= _n)
+                throw std::out_of_range("Matrix row index out of range");
+            return _row[n];
+        }
+#else
+            U &operator[](const uint32_t n) const { return _row[n]; }
+#endif
+            [[nodiscard]] uint32_t size() const { return _n; }
+            [[nodiscard]] U *data() const { return _row; }
+
+        private:
+            U *_row;
+            uint32_t _n;
+        };
+
+        Matrix() = default;
+
+        Matrix(const uint32_t rows, const uint32_t columns, const bool padded = false) {
+            resize(rows, columns, padded);
+        }
+#ifdef USE_BOUNDS_CHECKING
+    Row<const T> operator[](const uint32_t n) const
+    {
+        if (n >= _rows)
+            throw std::out_of_range("Matrix index out of range");
+        return Row<const T>(_matrix.data() + static_cast<std::size_t>(n) * _stride, _columns);
+    }
+    Row<T> operator[](const uint32_t n)
+    {
+        if (n >= _rows)
+            throw std::out_of_range("Matrix index out of range");
+        return Row<T>(_matrix.data() + static_cast<std::size_t>(n) * _stride, _columns);
+    }
+#else
+        Row<const T> operator[](const uint32_t n) const {
+            return Row<const T>(_matrix.data() + static_cast<std::size_t>(n) * _stride, _columns);
+        }
+
+        Row<T> operator[](const uint32_t n) {
+            return Row<T>(_matrix.data() + static_cast<std::size_t>(n) * _stride, _columns);
+        }
+#endif
+        static uint32_t dimensions() { return DIMENSIONS; }
+
+        void reset() {
+            _matrix.clear();
+            _rows = _columns = _stride = 0;
+        }
+
+        //! Returns the number of rows.
+        [[nodiscard]] uint32_t size() const { return _rows; }
+
+        //! Returns the number of columns.
+        [[nodiscard]] uint32_t columns() const { return _columns; }
+
+        //! Returns the distance, in elements, between the starts of adjacent rows.
+        [[nodiscard]] uint32_t stride() const { return _stride; }
+
+        //! Returns a pointer to the first element of the first row.
+        [[nodiscard]] const T *data() const { return _matrix.data(); }
+
+        //! Returns a pointer to the first element of the first row.
+        [[nodiscard]] T *data() { return _matrix.data(); }
+
+        //! Resizes to a square n-by-n matrix, discarding the old contents.
+        void resize(const uint32_t n) { resize(n, n, false); }
+
+        /*! Resizes the matrix, discarding the old contents.
+
+        @param rows The number of rows
+        @param columns The number of columns
+        @param padded If true, pad each row out to a whole number of cache lines */
+        void resize(const uint32_t rows, const uint32_t columns, const bool padded) {
+            constexpr auto perLine = static_cast<uint32_t>(std::max<std::size_t>(1, CACHE_LINE_SIZE / sizeof(T)));
+            _rows = rows;
+            _columns = columns;
+            _stride = padded ? ((columns + perLine - 1) / perLine) * perLine : columns;
+            _matrix.assign(static_cast<std::size_t>(_rows) * _stride, T());
+        }
+
+    protected:
+        static constexpr uint32_t DIMENSIONS = 2;
+        std::vector<T, AlignedAllocator<T> > _matrix;
+        uint32_t _rows{0}, _columns{0}, _stride{0};
+    };
+
+    //! A square matrix laid out like a padded DenseStorage one, but whose
+    //! size is a template parameter.
+
+    /*! With the row stride a compile-time constant, m[i][j] is a single
+        multiply-add the compiler can fold into the address, and loops over
+        a row have a known trip count.  The elements still live in one
+        heap block, allocated when the matrix is made, so that a large N
+        can't overflow the stack wherever a world is built.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<typename T, uint32_t Size>
+    class Matrix<T, 2, FixedStorage<Size> > {
+    public:
+        typedef T value_type;
+
+        //! A non-owning view of a single row.
+        template<typename U>
+        using Row = typename Matrix<T, 2, DenseStorage>::template Row<U>;
+
+        Matrix()
+            : _matrix(static_cast<std::size_t>(Size) * STRIDE) {
+        }
+#ifdef USE_BOUNDS_CHECKING
+    Row<const T> operator[](const uint32_t n) const
+    {
+        if (n >= Size)
+            throw std::out_of_range("Matrix index out of range");
+        return Row<const T>(_matrix.data() + static_cast<std::size_t>(n) * STRIDE, Size);
+    }
+    Row<T> operator[](const uint32_t n)
+    {
+        if (n >= Size)
+            throw std::out_of_range("Matrix index out of range");
+        return Row<T>(_matrix.data() + static_cast<std::size_t>(n) * STRIDE, Size);
+    }
+#else
+        Row<const T> operator[](const uint32_t n) const {
+            return Row<const T>(_matrix.data() + static_cast<std::size_t>(n) * STRIDE, Size);
+        }
+
+        Row<T> operator[](const uint32_t n) {
+            return Row<T>(_matrix.data() + static_cast<std::size_t>(n) * STRIDE, Size);
+        }
+#endif
+        static uint32_t dimensions() { return DIMENSIONS; }
+
+        //! Sets every element to T().
+        void reset() { std::fill(_matrix.begin(), _matrix.end(), T()); }
+
+        //! Returns the number of rows.
+        [[nodiscard]] static constexpr uint32_t size() { return Size; }
+
+        //! Returns the number of columns.
+        [[nodiscard]] static constexpr uint32_t columns() { return Size; }
+
+        //! Returns the distance, in elements, between the starts of adjacent rows.
+        [[nodiscard]] static constexpr uint32_t stride() { return STRIDE; }
+
+        //! Returns a pointer to the first element of the first row.
+        [[nodiscard]] const T *data() const { return _matrix.data(); }
+
+        //! Returns a pointer to the first element of the first row.
+        [[nodiscard]] T *data() { return _matrix.data(); }
+
+        /*! Clears the matrix.  Its shape can't change: this exists so code
+        written for DenseStorage works unchanged.
+
+        @param rows The number of rows, which must be Size
+        @param columns The number of columns, which must be Size
+        @param padded Ignored; rows are always padded to whole cache lines
+        @throw std::length_error if the matrix isn't Size by Size */
+        void resize(const uint32_t rows, const uint32_t columns, const bool padded) {
+            (void) padded;
+            if (rows != Size || columns != Size)
+                throw std::length_error("a fixed-size Matrix can't be resized");
+            reset();
+        }
+
+    protected:
+        static constexpr uint32_t DIMENSIONS = 2;
+        static constexpr uint32_t PER_LINE = static_cast<uint32_t>(
+            std::max<std::size_t>(1, CACHE_LINE_SIZE / sizeof(T)));
+        static constexpr uint32_t STRIDE = ((Size + PER_LINE - 1) / PER_LINE) * PER_LINE;
+        std::vector<T, AlignedAllocator<T> > _matrix;
+    };
+
+    //! A std::array with just enough of std::vector's interface to stand in
+    //! for one whose size never changes.
+
+    /*! @author Hansen
+        @since 2.5
+    */
+    template<typename T, std::size_t N>
+    struct FixedVector : std::array<T, N> {
+        /*! Fills the array, as resizing an empty vector would.
+
+        @param n The new size, which must be N
+        @param value The value to fill with
+        @throw std::length_error if n isn't N */
+        void resize(const std::size_t n, const T &value = T()) {
+            if (n != N)
+                throw std::length_error("a FixedVector can't be resized");
+            this->fill(value);
+        }
+
+        //! Copies in N elements.
+        template<class InputIt>
+        void assign(InputIt first, InputIt last) {
+#ifdef USE_BOUNDS_CHECKING
+            if (std::distance(first, last) != static_cast<std::ptrdiff_t>(N))
+                throw std::length_error("a FixedVector can't be resized");
+#endif
+            std::copy(first, last, this->begin());
+        }
+    };
+
+    //! The customers of a world as read from the input, one array per field.
+
+    /*! Each field is kept contiguously, indexed by customer, so anything
+        which reads one field of every customer (coordinates, say, when
+        working out travel times) reads nothing else.
+
+        @author Hansen
+        @since 2.5
+    */
+    struct Customers {
+        //! The number of fields each customer has in a Dumas file.
+        static constexpr uint32_t FIELDS = 6;
+
+        std::vector<double> x, y, demand, ready, due, service;
+
+        //! Returns the number of customers.
+        [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(x.size()); }
+
+        /*! Appends a customer.
+
+        @param fields Its FIELDS fields, in Dumas order: x, y, demand, ready
+        time, due date and service time */
+        void push_back(const double *fields) {
+            x.push_back(fields[0]);
+            y.push_back(fields[1]);
+            demand.push_back(fields[2]);
+            ready.push_back(fields[3]);
+            due.push_back(fields[4]);
+            service.push_back(fields[5]);
+        }
+
+        /*! Copies out a customer's fields.
+
+        @param customer The customer
+        @param fields Receives its FIELDS fields, in Dumas order */
+        void get(const uint32_t customer, double *fields) const {
+            fields[0] = x[customer];
+            fields[1] = y[customer];
+            fields[2] = demand[customer];
+            fields[3] = ready[customer];
+            fields[4] = due[customer];
+            fields[5] = service[customer];
+        }
+    };
+
+    //! When a customer may be served: no earlier than ready, and no later
+    //! than due without a penalty.
+
+    /*! A schedule always wants both ends of the window of the customer it's
+        visiting, so keeping them side by side costs one cache line per
+        customer rather than two.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class Time>
+    struct TimeWindow {
+        Time ready;
+        Time due;
+    };
+
+    //! A world's time windows, kept both paired up and split apart.
+
+    /*! paired() is what schedules read: both ends of a customer's window
+        side by side.  Every world also hands out lowDeadlines() and
+        deadlines() as vectors, though, and code written against that
+        interface keeps working only if they exist, so the two halves are
+        kept as well.  set() is the only way in and writes all three, so they
+        can never disagree; it's 4n numbers beside a travel-time table of n^2.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class Time>
+    class TimeWindows {
+    public:
+        //! Returns the number of customers.
+        [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(_paired.size()); }
+
+        //! Makes room for n customers, every window empty.
+        void resize(const uint32_t n) {
+            _paired.assign(n, TimeWindow<Time>{});
+            _ready.assign(n, Time{});
+            _due.assign(n, Time{});
+        }
+
+        /*! Sets a customer's window.
+
+        @param customer The customer
+        @param ready Its ready time, or low deadline
+        @param due Its due date, or deadline */
+        void set(const uint32_t customer, const Time ready, const Time due) {
+#ifdef USE_BOUNDS_CHECKING
+            _paired.at(customer) = {ready, due};
+            _ready.at(customer) = ready;
+            _due.at(customer) = due;
+#else
+            _paired[customer] = {ready, due};
+            _ready[customer] = ready;
+            _due[customer] = due;
+#endif
+        }
+
+        //! Returns every customer's window.
+        [[nodiscard]] const std::vector<TimeWindow<Time> > &paired() const { return _paired; }
+
+        //! Returns every customer's ready time.
+        [[nodiscard]] const std::vector<Time> &ready() const { return _ready; }
+
+        //! Returns every customer's due date.
+        [[nodiscard]] const std::vector<Time> &due() const { return _due; }
+
+    private:
+        std::vector<TimeWindow<Time> > _paired;
+        std::vector<Time> _ready, _due;
+    };
+
+    /*! Converts a time from the input into a world's TimeType, rounding
+        ready times up and due dates down if it's an integer.
+
+    @param time The time
+    @param ready True if it's a ready time, false if it's a due date
+    @return The converted time
+
+    @author Hansen
+    @since 2.5
+    */
+    template<class Time>
+    Time toTime(const double time, const bool ready) {
+        if constexpr (std::is_integral_v<Time>)
+            return static_cast<Time>(ready ? std::ceil(time) : std::floor(time));
+        else
+            return static_cast<Time>(time);
+    }
+
+    //! The candidate lists of a world: for each customer, the customers it
+    //! can be reached from most quickly, nearest first.
+
+    /*! These are the places it's most worth inserting a customer after, and
+        a solution whose neighborhood asks for it will draw insertion points
+        from them.  Worlds build them with build(), handing it a way to get
+        every travel time to one customer.
+
+        @author Hansen
+        @since 2.5
+    */
+    class CandidateLists {
+    public:
+        /*! Builds a candidate list for every customer.
+
+        @param numCustomers The number of customers
+        @param k The most candidates to keep for each customer
+        @param windows If not null, leave out any customer from which this
+        one can't be reached by its deadline even when leaving at the start
+        of that customer's window
+        @param timesTo Called as timesTo(c, times) to fill times[x], for
+        every customer x, with the travel time from x to c */
+        template<class Distance, class Time, class TimesTo>
+        void build(const uint32_t numCustomers, const uint32_t k, const std::vector<TimeWindow<Time> > *windows,
+                   const TimesTo &timesTo) {
+            const uint32_t width = std::min(k, numCustomers ? numCustomers - 1 : 0);
+            _table.resize(numCustomers, width, false);
+            _counts.assign(numCustomers, 0);
+            parallelFor(0, numCustomers, [this, numCustomers, width, windows, &timesTo](const uint32_t c) {
+                std::vector<Distance> times(numCustomers);
+                timesTo(c, times.data());
+                std::vector<std::pair<Distance, int> > nearest;
+                nearest.reserve(numCustomers);
+                for (uint32_t x = 0; x < numCustomers; x += 1) {
+                    if (x == c || (windows && (*windows)[x].ready + times[x] > (*windows)[c].due))
+                        continue;
+                    nearest.emplace_back(times[x], x);
+                }
+                const auto kept = std::min<std::size_t>(width, nearest.size());
+                std::partial_sort(nearest.begin(), nearest.begin() + kept, nearest.end());
+                for (std::size_t i = 0; i < kept; i += 1)
+                    _table[c][i] = nearest[i].second;
+                _counts[c] = kept;
+            });
+        }
+
+        /*! Returns the candidate lists, one row per customer.  Only the first
+        count() entries of each row are meaningful. */
+        [[nodiscard]] const Matrix<int, 2, DenseStorage> &table() const { return _table; }
+
+        /*! Returns how many candidates a customer has.
+
+        @param customer The customer
+        @return The length of its candidate list, or 0 if there are none */
+        [[nodiscard]] uint32_t count(const uint32_t customer) const {
+            return customer < _counts.size() ? _counts[customer] : 0;
+        }
+
+    private:
+        Matrix<int, 2, DenseStorage> _table;
+        std::vector<uint32_t> _counts;
+    };
+
+    //! Whether a character is whitespace in Dumas data.
+    inline bool isDumasSpace(const char ch) {
+        return ' ' == ch || '\t' == ch || '\r' == ch || '\v' == ch || '\f' == ch || '\n' == ch;
+    }
+
+    //! Whether a character is a digit in Dumas data.
+    inline bool isDumasDigit(const char ch) { return ch >= '0' && ch <= '9'; }
+
+    /*! Parses one line of Dumas data: leading whitespace, an unsigned
+        customer number, then six whitespace-separated numbers of the form
+        [+-]?[0-9]*[.]?[0-9]+, then optional trailing whitespace.
+
+    @param line The line, without its newline
+    @param customer Receives the customer number
+    @param row Receives the six numeric fields
+    @return True if the line was well-formed
+
+    @author Hansen
+    @since 2.5
+    */
+    inline bool parseDumasLine(const std::string_view line, uint32_t &customer, std::vector<double> &row) {
+        const char *p = line.data();
+        const char *const end = p + line.size();
+        while (p != end && isDumasSpace(*p))
+            ++p;
+        const char *token = p;
+        while (p != end && isDumasDigit(*p))
+            ++p;
+        if (p == token)
+            return false;
+        const auto [last, ec] = std::from_chars(token, p, customer);
+        if (std::errc{} != ec)
+            customer = 0;
+        for (uint32_t i = 0; i < 6; i += 1) {
+            if (p == end || !isDumasSpace(*p))
+                return false;
+            while (p != end && isDumasSpace(*p))
+                ++p;
+            token = p;
+            if (p != end && ('+' == *p || '-' == *p))
+                ++p;
+            const char *digits = p;
+            while (p != end && isDumasDigit(*p))
+                ++p;
+            if (p != end && '.' == *p) {
+                digits = ++p;
+                while (p != end && isDumasDigit(*p))
+                    ++p;
+            }
+            if (p == digits)
+                return false;
+            if ('+' == *token)
+                ++token;
+            std::from_chars(token, p, row[i]);
+        }
+        while (p != end && isDumasSpace(*p))
+            ++p;
+        return p == end;
+    }
+
+    /*! Reads every customer from Dumas data.  Every newline-terminated line
+        consisting of a customer number followed by six numeric fields becomes
+        a row; everything else is ignored.  A customer number of 999 ends the
+        data.  The input is scanned once and never copied.
+
+    @param dumasStr The Dumas data
+    @param customers Receives the customers
+
+    @author Hansen
+    @since 2.5
+    */
+    inline void readDumasRows(const std::string_view dumasStr, Customers &customers) {
+        std::size_t begin = 0, pos = 0;
+        uint32_t customer = 0;
+        std::vector<double> row(Customers::FIELDS);
+        while ((pos = dumasStr.find('\n', begin)) != std::string_view::npos) {
+            if (parseDumasLine(dumasStr.substr(begin, pos - begin), customer, row)) {
+                if (999 == customer)
+                    break;
+                customers.push_back(row.data());
+            }
+            begin = pos + 1;
+        }
+    }
+
+    //! A class representing an instance of the Traveling Salesman Problem with Time
+    //! Windows.
+
+    /*! Travel times are stored as Distance.  Every one is floored when it's
+        computed, so an unsigned integer type loses nothing and shrinks the
+        travel-time matrix, which is what TravelingSalesmanSolution spends most
+        of its time reading, to a half or a quarter of its size as doubles.
+        Worlds with integer travel times keep their time windows, and do all
+        their schedule arithmetic, in TimeType: 64-bit signed integers.  Ready
+        times are rounded up and due dates down, which changes nothing for
+        integral data such as Dumas's.
+
+        TravelingSalesmanWorld is the version with double travel times; use,
+        say, <tt>TravelingSalesmanSolution<BasicTravelingSalesmanWorld<uint16_t> ></tt>
+        for a compact one.  Loading a world whose travel times don't fit in
+        Distance throws std::overflow_error.
+
+        If Size isn't zero, the world holds exactly that many customers
+        (the depot included), its travel times are kept in a Matrix whose
+        shape is fixed at compile time, and a TravelingSalesmanSolution of it
+        keeps its tour and schedule in std::arrays.  That's worth doing when
+        solving a great many small instances of one size.  Loading an instance
+        of any other size throws std::length_error.
+
+        @author Hansen, Ohlmann, Thomas
+        @since 1.0
+    */
+    template<class Distance = double, uint32_t Size = 0>
+    class BasicTravelingSalesmanWorld {
+    public:
+        static_assert(std::is_arithmetic_v<Distance>, "travel times must be numbers");
+
+        //! The type in which travel times are stored.
+        typedef Distance DistanceType;
+
+        //! The type in which time windows are stored and schedules computed.
+        typedef std::conditional_t<std::is_floating_point_v<Distance>, Distance, int64_t> TimeType;
+
+        //! The type of the travel-time matrix.
+        typedef std::conditional_t<0 == Size, Matrix<Distance, 2, DenseStorage>,
+            Matrix<Distance, 2, FixedStorage<Size> > > TravelTimeMatrix;
+
+        //! The number of customers every instance of this world has, or zero
+        //! if it varies.
+        static constexpr uint32_t CUSTOMERS = Size;
+
+        /*! Controls whether travel times are closed under the triangle
+            inequality after loading.
+
+            Enforce runs an all-pairs shortest path closure, which is O(n^3).
+            AssumeMetric skips it, which is only safe if you know the input
+            already satisfies the triangle inequality.  Be careful with
+            Euclidean data: since each travel time is floored, a detour can
+            come out up to one unit shorter than the direct route. */
+        enum class Closure { Enforce, AssumeMetric };
+
+        BasicTravelingSalesmanWorld() = default;
+
+        /*! Loads a world from a file in Dumas format.
+
+        The file is memory-mapped and parsed in place.
+
+        @param filename The file to read
+        @param closure Whether to enforce the triangle inequality on the
+        travel times */
+        static BasicTravelingSalesmanWorld loadFromDumasFile(const std::string &filename,
+                                                             const Closure closure = Closure::Enforce) {
+            const MappedFile file(filename);
+            return loadFromDumasString(file.view(), closure);
+        };
+
+        /*! Loads a world from a string in Dumas format.
+
+        Every newline-terminated line consisting of a customer number followed
+        by six numeric fields becomes a customer; everything else is ignored.
+        A customer number of 999 ends the data.  The input is scanned once and
+        never copied.
+
+        @param dumasStr The Dumas data
+        @param closure Whether to enforce the triangle inequality on the
+        travel times */
+        static BasicTravelingSalesmanWorld loadFromDumasString(const std::string_view dumasStr,
+                                                               const Closure closure = Closure::Enforce) {
+            BasicTravelingSalesmanWorld tsp;
+            tsp._closure = closure;
+            readDumasRows(dumasStr, tsp._customers);
+            tsp.computeTravelTimes();
+            return tsp;
+        };
+
+        /*! Loads a world from a binary snapshot written by saveSnapshot().
+
+        The snapshot is memory-mapped and copied straight into place: there's
+        no parsing and the travel times are not recomputed.  Snapshots are
+        written in the byte order of the machine that made them, and loading
+        one from a machine with a different byte order will fail.
+
+        @param filename The snapshot to read
+        @throw std::runtime_error if the file can't be read or isn't a valid
+        snapshot */
+        static BasicTravelingSalesmanWorld loadFromSnapshot(const std::string &filename) {
+            const MappedFile file(filename);
+            if (!file.isOpen())
+                throw std::runtime_error("couldn't open snapshot " + filename);
+            SnapshotHeader header;
+            if (file.size() < sizeof(header))
+                throw std::runtime_error("truncated snapshot " + filename);
+            std::memcpy(&header, file.data(), sizeof(header));
+            if (0 != std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) ||
+                SNAPSHOT_VERSION != header.version || SNAPSHOT_BYTE_ORDER != header.byteOrder ||
+                SNAPSHOT_FIELDS != header.fields || SNAPSHOT_DISTANCE != header.distance)
+                throw std::runtime_error("unrecognized snapshot " + filename);
+            const std::size_t n = header.customers;
+            if (file.size() != snapshotSize(n))
+                throw std::runtime_error("truncated snapshot " + filename);
+            checkSize(n);
+
+            BasicTravelingSalesmanWorld tsp;
+            const char *cursor = file.data() + sizeof(header);
+            auto next = [&cursor]<class T>(T *out, const std::size_t count) {
+                std::memcpy(out, cursor, count * sizeof(T));
+                cursor += count * sizeof(T);
+            };
+            double row[SNAPSHOT_FIELDS];
+            for (std::size_t i = 0; i < n; i += 1) {
+                next(row, SNAPSHOT_FIELDS);
+                tsp._customers.push_back(row);
+            }
+            tsp._timeMatrix.resize(n, n, true);
+            for (std::size_t i = 0; i < n; i += 1)
+                next(tsp._timeMatrix[i].data(), n);
+            std::vector<double> ready(n), due(n);
+            next(ready.data(), n);
+            next(due.data(), n);
+            tsp._windows.resize(n);
+            for (std::size_t i = 0; i < n; i += 1)
+                tsp._windows.set(i, static_cast<TimeType>(ready[i]), static_cast<TimeType>(due[i]));
+            return tsp;
+        }
+
+        /*! Writes this world to a binary snapshot which loadFromSnapshot() can
+        read back without any recomputation.
+
+        @param filename The file to write
+        @throw std::runtime_error if the file can't be written */
+        void saveSnapshot(const std::string &filename) const {
+            std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+            SnapshotHeader header;
+            header.customers = _customers.size();
+            auto write = [&out]<class T>(const T *in, const std::size_t count) {
+                out.write(reinterpret_cast<const char *>(in),
+                          static_cast<std::streamsize>(count * sizeof(T)));
+            };
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            double row[SNAPSHOT_FIELDS];
+            for (uint32_t i = 0; i < _customers.size(); i += 1) {
+                _customers.get(i, row);
+                write(row, SNAPSHOT_FIELDS);
+            }
+            for (uint32_t i = 0; i < _timeMatrix.size(); i += 1)
+                write(_timeMatrix[i].data(), _timeMatrix.columns());
+            const std::vector<double> lowdeadlines(_windows.ready().begin(), _windows.ready().end());
+            const std::vector<double> deadlines(_windows.due().begin(), _windows.due().end());
+            write(lowdeadlines.data(), lowdeadlines.size());
+            write(deadlines.data(), deadlines.size());
+            if (!out.flush())
+                throw std::runtime_error("couldn't write snapshot " + filename);
+        }
+
+        virtual ~BasicTravelingSalesmanWorld() = default;
+
+        [[nodiscard]] const TravelTimeMatrix &travelTimes() const { return _timeMatrix; }
+        [[nodiscard]] const std::vector<TimeType> &lowDeadlines() const { return _windows.ready(); }
+        [[nodiscard]] const std::vector<TimeType> &deadlines() const { return _windows.due(); }
+
+        //! Returns each customer's time window: the low deadline and the
+        //! deadline together.
+        [[nodiscard]] const std::vector<TimeWindow<TimeType> > &windows() const { return _windows.paired(); }
+
+        //! Returns a const-reference to the customers this world was loaded from.
+        [[nodiscard]] const Customers &data() const { return _customers; }
+
+        //! Returns a reference to the customers this world was loaded from.
+        [[nodiscard]] Customers &data() { return _customers; }
+
+        //! Returns a const reference to the identifying string used for this World.
+        [[nodiscard]] const std::string &identifier() const { return _identifier; }
+
+        /*! Builds a candidate list for every customer: the k customers it can be
+        reached from most quickly, nearest first.  These are the places it's
+        most worth inserting the customer after, and a solution whose
+        neighborhood asks for it will draw insertion points from them.
+
+        Candidate lists aren't saved in snapshots; call this again after
+        loading one.
+
+        @param k The most candidates to keep for each customer
+        @param windows If true, leave out any customer from which this one
+        can't be reached by its deadline even when leaving at the start of
+        that customer's window */
+        void computeCandidates(const uint32_t k, const bool windows = false) {
+            const uint32_t numCustomers = _timeMatrix.size();
+            _candidates.build<Distance>(numCustomers, k, windows ? &_windows.paired() : nullptr,
+                                        [this, numCustomers](const uint32_t c, Distance *times) {
+                                            for (uint32_t x = 0; x < numCustomers; x += 1)
+                                                times[x] = _timeMatrix[x][c];
+                                        });
+        }
+
+        /*! Returns the candidate lists built by computeCandidates(), one row per
+        customer.  Only the first candidateCount() entries of each row are
+        meaningful. */
+        [[nodiscard]] const Matrix<int, 2, DenseStorage> &candidates() const { return _candidates.table(); }
+
+        /*! Returns how many candidates a customer has.
+
+        @param customer The customer
+        @return The length of its candidate list, or 0 if there are none */
+        [[nodiscard]] uint32_t candidateCount(const uint32_t customer) const { return _candidates.count(customer); }
+
+    protected:
+        TravelTimeMatrix _timeMatrix;
+        Customers _customers;
+        TimeWindows<TimeType> _windows;
+        std::string _identifier;
+        CandidateLists _candidates;
+
+        virtual void computeTravelTimes() {
+            uint32_t numCustomers = _customers.size();
+            checkSize(numCustomers);
+            _timeMatrix.resize(numCustomers, numCustomers, true);
+            parallelFor(0, numCustomers, [this, numCustomers](const uint32_t i) {
+                const double *xs = _customers.x.data(), *ys = _customers.y.data();
+                const double x = xs[i], y = ys[i];
+                for (uint32_t j = 0; j < numCustomers; j++) {
+                    const double time = ::floor(::sqrt((x - xs[j]) * (x - xs[j]) + (y - ys[j]) * (y - ys[j])));
+                    if constexpr (std::is_integral_v<Distance>)
+                        if (time > static_cast<double>(std::numeric_limits<Distance>::max()))
+                            throw std::overflow_error("travel time too large for the distance type");
+                    _timeMatrix[i][j] = static_cast<Distance>(time);
+                }
+            });
+            if (Closure::Enforce == _closure)
+                enforceTriangleInequality();
+            _windows.resize(numCustomers);
+            for (uint32_t i = 0; i < numCustomers; i++)
+                _windows.set(i, toTime<TimeType>(_customers.ready[i], true),
+                             toTime<TimeType>(_customers.due[i], false));
+        }
+
+
+        /*! Replaces every travel time with the length of the shortest path
+            between the two customers.
+
+            This is Floyd-Warshall, blocked so each step works on tiles that
+            fit in cache.  For each pivot tile we first close the tile on the
+            diagonal, then the tiles sharing its row and column, then
+            everything else.  Tiles within the last two phases don't depend on
+            each other, so those are spread across all available threads. */
+        void enforceTriangleInequality() {
+            const uint32_t numCustomers = _timeMatrix.size();
+            const uint32_t blocks = (numCustomers + CLOSURE_BLOCK - 1) / CLOSURE_BLOCK;
+            for (uint32_t kb = 0; kb < blocks; kb += 1) {
+                relaxBlock(kb, kb, kb);
+                parallelFor(0, blocks, [this, kb](const uint32_t b) {
+                    if (b == kb)
+                        return;
+                    relaxBlock(kb, b, kb);
+                    relaxBlock(b, kb, kb);
+                });
+                parallelFor(0, blocks, [this, kb, blocks](const uint32_t ib) {
+                    if (ib == kb)
+                        return;
+                    for (uint32_t jb = 0; jb < blocks; jb += 1)
+                        if (jb != kb)
+                            relaxBlock(ib, jb, kb);
+                });
+            }
+        }
+
+    private:
+        static constexpr uint32_t CLOSURE_BLOCK = 64;
+        static constexpr char SNAPSHOT_MAGIC[8] = {'D', 'J', 'I', 'N', 'N', 'I', 'W', '\0'};
+        static constexpr uint32_t SNAPSHOT_VERSION = 1;
+        static constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+        static constexpr uint32_t SNAPSHOT_FIELDS = Customers::FIELDS;
+        // Zero for doubles, so snapshots of TravelingSalesmanWorld are as before
+        static constexpr uint32_t SNAPSHOT_DISTANCE = std::is_same_v<Distance, double>
+                                                          ? 0
+                                                          : (std::is_integral_v<Distance> ? 0x100 : 0x200) +
+                                                            static_cast<uint32_t>(sizeof(Distance));
+        Closure _closure{Closure::Enforce};
+
+        /*! The fixed-size header at the start of every snapshot.  It's followed
+            by the customer rows, the travel-time matrix (unpadded, row-major,
+            as Distance), the low deadlines and the deadlines; everything but
+            the matrix is stored as doubles. */
+        struct SnapshotHeader {
+            char magic[8] = {'D', 'J', 'I', 'N', 'N', 'I', 'W', '\0'};
+            uint32_t version = SNAPSHOT_VERSION;
+            uint32_t byteOrder = SNAPSHOT_BYTE_ORDER;
+            uint32_t fields = SNAPSHOT_FIELDS;
+            uint32_t customers = 0;
+            uint32_t distance = SNAPSHOT_DISTANCE;
+            uint32_t reserved = 0;
+        };
+
+        /*! Makes sure a world of fixed Size is being given that many customers.
+
+        @param n The number of customers
+        @throw std::length_error if Size isn't zero and n isn't Size */
+        static void checkSize(const std::size_t n) {
+            if constexpr (0 != Size)
+                if (n != Size)
+                    throw std::length_error("this world holds exactly " + std::to_string(Size) +
+                                            " customers, not " + std::to_string(n));
+        }
+
+        static std::size_t snapshotSize(const std::size_t n) {
+            return sizeof(SnapshotHeader) + (n * SNAPSHOT_FIELDS + 2 * n) * sizeof(double) +
+                   n * n * sizeof(Distance);
+        }
+
+        /*! Relaxes every path in tile (ib, jb) through the pivots in tile kb.
+
+        The pivot row is copied to the stack first: the compiler can then
+        prove the inner loop doesn't alias and will happily vectorize it. */
+        void relaxBlock(const uint32_t ib, const uint32_t jb, const uint32_t kb) {
+            const uint32_t numCustomers = _timeMatrix.size();
+            const uint32_t iEnd = std::min(numCustomers, (ib + 1) * CLOSURE_BLOCK);
+            const uint32_t jBegin = jb * CLOSURE_BLOCK;
+            const uint32_t jLen = std::min(numCustomers, jBegin + CLOSURE_BLOCK) - jBegin;
+            const uint32_t kEnd = std::min(numCustomers, (kb + 1) * CLOSURE_BLOCK);
+            Distance *times = _timeMatrix.data();
+            const std::size_t stride = _timeMatrix.stride();
+            TimeType pivotRow[CLOSURE_BLOCK];
+            for (uint32_t k = kb * CLOSURE_BLOCK; k < kEnd; k += 1) {
+                std::copy_n(times + k * stride + jBegin, jLen, pivotRow);
+                for (uint32_t i = ib * CLOSURE_BLOCK; i < iEnd; i += 1) {
+                    Distance *row = times + i * stride + jBegin;
+                    const TimeType viaPivot = times[i * stride + k];
+                    for (uint32_t j = 0; j < jLen; j += 1)
+                        row[j] = static_cast<Distance>(std::min<TimeType>(row[j], viaPivot + pivotRow[j]));
+                }
+            }
+        }
+    };
+
+    //! A TravelingSalesmanWorld with double travel times, as in earlier versions.
+    typedef BasicTravelingSalesmanWorld<> TravelingSalesmanWorld;
+
+    //! An instance of the Traveling Salesman Problem with Time Windows whose
+    //! travel times are worked out when they're needed rather than stored.
+
+    /*! A TravelingSalesmanWorld holds every travel time: for 20,000
+        customers that's 3.2GB of doubles, and closing it under the triangle
+        inequality is O(n^3).  This world keeps only the customers'
+        coordinates and computes each travel time, the floor of the Euclidean
+        distance, as it's asked for.  Those are exactly the times a
+        TravelingSalesmanWorld loaded with Closure::AssumeMetric holds.
+
+        There's no cache: each lookup reads two coordinate pairs which sit
+        side by side, and a square root is cheaper than the cache miss a large
+        stored matrix costs on almost every lookup.  Where many travel times
+        from one customer are wanted at once, as in computeCandidates(),
+        TravelTimes::row() works them out two at a time with SSE2 on x86-64.
+
+        Distance and TimeType mean what they do for BasicTravelingSalesmanWorld.
+
+        @author Hansen
+        @since 2.5
+    */
+    template<class Distance = double>
+    class BasicLazyTravelingSalesmanWorld {
+    public:
+        static_assert(std::is_arithmetic_v<Distance>, "travel times must be numbers");
+
+        //! The type in which travel times are returned.
+        typedef Distance DistanceType;
+
+        //! The type in which time windows are stored and schedules computed.
+        typedef std::conditional_t<std::is_floating_point_v<Distance>, Distance, int64_t> TimeType;
+
+        //! Stands in for a travel-time matrix, computing entries on demand.
+        class TravelTimes {
+        public:
+            //! The travel times from one customer.
+            class Row {
+            public:
+                Row(const double *from, const double *xy, const uint32_t n)
+                    : _from(from), _xy(xy), _n(n) {
+                }
+
+                //! Returns the travel time to a customer.
+                Distance operator[](const uint32_t to) const {
+#ifdef USE_BOUNDS_CHECKING
+                    if (to >= _n)
+                        throw std::out_of_range("travel time index out of range");
+#endif
+                    const double dx = _from[0] - _xy[2 * to];
+                    const double dy = _from[1] - _xy[2 * to + 1];
+                    return static_cast<Distance>(::floor(::sqrt(dx * dx + dy * dy)));
+                }
+
+                [[nodiscard]] uint32_t size() const { return _n; }
+
+            private:
+                const double *_from, *_xy;
+                uint32_t _n;
+            };
+
+            //! Returns the travel times from a customer.
+            Row operator[](const uint32_t from) const {
+#ifdef USE_BOUNDS_CHECKING
+                if (from >= size())
+                    throw std::out_of_range("travel time index out of range");
+#endif
+                return Row(_xy.data() + 2 * static_cast<std::size_t>(from), _xy.data(), size());
+            }
+
+            //! Returns the number of customers.
+            [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(_xy.size() / 2); }
+
+            /*! Works out the travel times from one customer to a run of others.
+
+            @param from The customer to travel from
+            @param first The first customer to travel to
+            @param count How many customers, from first on, to travel to
+            @param out Receives the count travel times */
+            void row(const uint32_t from, const uint32_t first, const uint32_t count, Distance *out) const {
+                uint32_t k = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+                if (_truncates) {
+                    const __m128d x = _mm_set1_pd(_xy[2 * from]);
+                    const __m128d y = _mm_set1_pd(_xy[2 * from + 1]);
+                    const double *to = _xy.data() + 2 * static_cast<std::size_t>(first);
+                    for (; k + 2 <= count; k += 2, to += 4) {
+                        const __m128d a = _mm_loadu_pd(to);
+                        const __m128d b = _mm_loadu_pd(to + 2);
+                        const __m128d dx = _mm_sub_pd(x, _mm_unpacklo_pd(a, b));
+                        const __m128d dy = _mm_sub_pd(y, _mm_unpackhi_pd(a, b));
+                        const __m128i t = _mm_cvttpd_epi32(
+                            _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy))));
+                        out[k] = static_cast<Distance>(_mm_cvtsi128_si32(t));
+                        out[k + 1] = static_cast<Distance>(_mm_cvtsi128_si32(_mm_shuffle_epi32(t, 1)));
+                    }
+                }
+#endif
+                const Row times = (*this)[from];
+                for (; k < count; k += 1)
+                    out[k] = times[first + k];
+            }
+
+        private:
+            friend class BasicLazyTravelingSalesmanWorld;
+
+            // Each customer's x and y, side by side
+            std::vector<double, AlignedAllocator<double> > _xy;
+            // Whether every travel time fits in an int, so truncating the
+            // square root with SSE2 floors it
+            bool _truncates{false};
+        };
+
+        BasicLazyTravelingSalesmanWorld() = default;
+
+        /*! Loads a world from a file in Dumas format.
+
+        @param filename The file to read */
+        static BasicLazyTravelingSalesmanWorld loadFromDumasFile(const std::string &filename) {
+            const MappedFile file(filename);
+            return loadFromDumasString(file.view());
+        }
+
+        /*! Loads a world from a string in Dumas format; see readDumasRows().
+
+        @param dumasStr The Dumas data
+        @throw std::overflow_error if travel times could be too large for
+        Distance */
+        static BasicLazyTravelingSalesmanWorld loadFromDumasString(const std::string_view dumasStr) {
+            BasicLazyTravelingSalesmanWorld tsp;
+            readDumasRows(dumasStr, tsp._customers);
+            tsp.prepare();
+            return tsp;
+        }
+
+        virtual ~BasicLazyTravelingSalesmanWorld() = default;
+
+        [[nodiscard]] const TravelTimes &travelTimes() const { return _times; }
+        [[nodiscard]] const std::vector<TimeType> &lowDeadlines() const { return _windows.ready(); }
+        [[nodiscard]] const std::vector<TimeType> &deadlines() const { return _windows.due(); }
+
+        //! Returns each customer's time window: the low deadline and the
+        //! deadline together.
+        [[nodiscard]] const std::vector<TimeWindow<TimeType> > &windows() const { return _windows.paired(); }
+
+        //! Returns a const-reference to the customers this world was loaded from.
+        [[nodiscard]] const Customers &data() const { return _customers; }
+
+        //! Returns a const reference to the identifying string used for this World.
+        [[nodiscard]] const std::string &identifier() const { return _identifier; }
+
+        /*! Builds a candidate list for every customer, just as
+        BasicTravelingSalesmanWorld::computeCandidates() does.  It takes
+        O(n^2) time but only O(nk) memory.
+
+        @param k The most candidates to keep for each customer
+        @param windows If true, leave out any customer from which this one
+        can't be reached by its deadline even when leaving at the start of
+        that customer's window */
+        void computeCandidates(const uint32_t k, const bool windows = false) {
+            const uint32_t numCustomers = _times.size();
+            // Euclidean travel times are symmetric, so the times from c are
+            // the times to it
+            _candidates.build<Distance>(numCustomers, k, windows ? &_windows.paired() : nullptr,
+                                        [this, numCustomers](const uint32_t c, Distance *times) {
+                                            _times.row(c, 0, numCustomers, times);
+                                        });
+        }
+
+        //! Returns the candidate lists built by computeCandidates().
+        [[nodiscard]] const Matrix<int, 2, DenseStorage> &candidates() const { return _candidates.table(); }
+
+        //! Returns how many candidates a customer has.
+        [[nodiscard]] uint32_t candidateCount(const uint32_t customer) const { return _candidates.count(customer); }
+
+    protected:
+        Customers _customers;
+        TravelTimes _times;
+        TimeWindows<TimeType> _windows;
+        std::string _identifier;
+        CandidateLists _candidates;
+
+        /*! Gathers the coordinates and time windows out of the customers. */
+        void prepare() {
+            const uint32_t numCustomers = _customers.size();
+            _times._xy.resize(2 * static_cast<std::size_t>(numCustomers));
+            _windows.resize(numCustomers);
+            double lowX = 0, highX = 0, lowY = 0, highY = 0;
+            for (uint32_t i = 0; i < numCustomers; i++) {
+                const double x = _customers.x[i], y = _customers.y[i];
+                _times._xy[2 * i] = x;
+                _times._xy[2 * i + 1] = y;
+                lowX = i ? std::min(lowX, x) : x;
+                highX = i ? std::max(highX, x) : x;
+                lowY = i ? std::min(lowY, y) : y;
+                highY = i ? std::max(highY, y) : y;
+                _windows.set(i, toTime<TimeType>(_customers.ready[i], true),
+                             toTime<TimeType>(_customers.due[i], false));
+            }
+            const double longest = ::floor(std::hypot(highX - lowX, highY - lowY));
+            if constexpr (std::is_integral_v<Distance>)
+                if (longest > static_cast<double>(std::numeric_limits<Distance>::max()))
+                    throw std::overflow_error("travel times could be too large for the distance type");
+            _times._truncates = longest < static_cast<double>(std::numeric_limits<int>::max());
+        }
+
+    };
+
+    //! A lazily computed TravelingSalesmanWorld with double travel times.
+    typedef BasicLazyTravelingSalesmanWorld<> LazyTravelingSalesmanWorld;
+
+    //! The type in which a world keeps its time windows: its TimeType if it
+    //! declares one, otherwise double.
+    template<class WorldType>
+    struct WorldTime {
+        typedef double type;
+    };
+
+    template<class WorldType> requires requires { typename WorldType::TimeType; }
+    struct WorldTime<WorldType> {
+        typedef typename WorldType::TimeType type;
+    };
+
+    //! The number of customers every instance of a world has: its CUSTOMERS
+    //! if it declares one, otherwise zero, meaning it varies.
+    template<class WorldType>
+    struct WorldCustomers {
+        static constexpr uint32_t value = 0;
+    };
+
+    template<class WorldType> requires requires { WorldType::CUSTOMERS; }
+    struct WorldCustomers<WorldType> {
+        static constexpr uint32_t value = WorldType::CUSTOMERS;
+    };
+
+    //! A world's time windows as a solution reads them: windows() if the
+    //! world has it, otherwise its lowDeadlines() and deadlines().
+    template<class WorldType>
+    class WorldWindows {
+    public:
+        typedef typename WorldTime<WorldType>::type TimeType;
+
+        explicit WorldWindows(const WorldType &w) : _ready(w.lowDeadlines()), _due(w.deadlines()) {}
+
+        [[nodiscard]] TimeType ready(const uint32_t customer) const { return _ready[customer]; }
+        [[nodiscard]] TimeType due(const uint32_t customer) const { return _due[customer]; }
+
+    private:
+        const std::vector<TimeType> &_ready;
+        const std::vector<TimeType> &_due;
+    };
+
+    template<class WorldType> requires requires(const WorldType &w) { w.windows(); }
+    class WorldWindows<WorldType> {
+    public:
+        typedef typename WorldTime<WorldType>::type TimeType;
+
+        explicit WorldWindows(const WorldType &w) : _windows(w.windows()) {}
+
+        [[nodiscard]] TimeType ready(const uint32_t customer) const { return _windows[customer].ready; }
+        [[nodiscard]] TimeType due(const uint32_t customer) const { return _windows[customer].due; }
+
+    private:
+        const std::vector<TimeWindow<TimeType> > &_windows;
+    };
+
+    //! A representation of information needed for the Traveling Salesman Problem.
+    /*! While many different WorldTypes can be used with TravelingSalesmanSolution, it has been most
+        thoroughly tested with TravelingSalesmanWorld.  Attempting to use other world types may
+        shake loose some interesting bugs.  Or they might not and our code could
+        be perfect.  We don't know.  Don't panic, and have fun.
+
+        If Size isn't zero the tour and its schedule are kept in
+        std::arrays of that size, so copying a solution never touches the heap
+        and every loop over the tour has a trip count known at compile time.
+        It defaults to the world's CUSTOMERS, if it has one.  Building a
+        solution from a world of any other size throws std::length_error.
+
+        @author Hansen, Thiede
+        @since 2.0
+    */
+    template<class WorldType, uint32_t Size = WorldCustomers<WorldType>::value>
+    class TravelingSalesmanSolution {
+    public:
+        //! The type in which arrival times, penalties and slack are computed.
+        /*! For worlds with integer travel times this is an integer too, and
+            schedules are exact. */
+        typedef typename WorldTime<WorldType>::type TimeType;
+
+        //! The container a solution keeps one T per tour position or customer in.
+        template<class T>
+        using Storage = std::conditional_t<0 == Size, std::vector<T>, FixedVector<T, Size> >;
+
+        /*! A constructor that uses an already initialized World object.
+        @param w A WorldType object */
+        explicit TravelingSalesmanSolution(const WorldType &w)
+            : _w(new WorldType(w)),
+              _f{0.0},
+              _p{0.0},
+              _time{0.0},
+              _cost{0.0},
+              _timeWait{0.0},
+              _firstswitch{0},
+              _secondswitch{0},
+              _firstarrival{0},
+              _firstpenalty{0} {
+            _solution.resize(_w->data().size(), 0);
+            _arrivaltime.resize(_solution.size(), 0);
+            _penaltysum.resize(_solution.size(), 0);
+            _position.resize(_solution.size(), 0);
+            _slack.resize(_solution.size(), 0);
+            _identifier = "TravelingSalesmanSolution";
+        }
+
+        /*! A constructor that shares an already initialized World object rather
+        than copying it.  Copies of this solution (and any Annealers built from
+        it) will share it too, so it must not be modified afterwards.
+        @param w A shared pointer to a WorldType object */
+        explicit TravelingSalesmanSolution(std::shared_ptr<WorldType> w)
+            : _w(std::move(w)),
+              _f{0.0},
+              _p{0.0},
+              _time{0.0},
+              _cost{0.0},
+              _timeWait{0.0},
+              _firstswitch{0},
+              _secondswitch{0},
+              _firstarrival{0},
+              _firstpenalty{0} {
+            _solution.resize(_w->data().size(), 0);
+            _arrivaltime.resize(_solution.size(), 0);
+            _penaltysum.resize(_solution.size(), 0);
+            _position.resize(_solution.size(), 0);
+            _slack.resize(_solution.size(), 0);
+            _identifier = "TravelingSalesmanSolution";
+        }
+
+        /*! A constructor that initializes a new WorldType.
+
+        @param worldParam A char* containing parameters used to initialize a new
+        object of type WorldType */
+        explicit TravelingSalesmanSolution(const char *worldParam)
+            : _w(new WorldType{}),
+              _f{0.0},
+              _p{0.0},
+              _time{0.0},
+              _cost{0.0},
+              _timeWait{0.0},
+              _firstswitch{0},
+              _secondswitch{0},
+              _firstarrival{0},
+              _firstpenalty{0} {
+            *_w = WorldType::loadFromDumasFile();
+            _solution.resize(_w->data().size(), 0);
+            _arrivaltime.resize(_solution.size(), 0);
+            _penaltysum.resize(_solution.size(), 0);
+            _position.resize(_solution.size(), 0);
+            _slack.resize(_solution.size(), 0);
+            _identifier = "TravelingSalesmanSolution";
+        }
+
+        /*! Virtualized for the benefit of future subclassing. */
+        virtual ~TravelingSalesmanSolution() = default;
+
+        /*! Sets the Feasible component of the solution
+        @param f The new feasible component */
+        void setF(const double &f) { _f = f; }
+
+        /*! Sets the Penalty component of the solution
+        @param p The new penalty component */
+        void setP(const double &p) { _p = p; }
+
+        /*! Returns the Feasible component of the solution
+        @return The feasible component of the current solution */
+        [[nodiscard]] double getF() const { return _f; }
+
+        /*! Returns the Penalty component of the solution
+        @return the Penalty component of the current solution */
+        [[nodiscard]] double getP() const { return _p; }
+
+        /*! Generates a neighbor TravelingSalesmanSolution from this current TravelingSalesmanSolution,
+        drawing random numbers from this thread's default generator.
+        @param neighbor The TravelingSalesmanSolution object which will receive the value.*/
+        void generateNeighbor(TravelingSalesmanSolution &neighbor) {
+            generateNeighbor(neighbor, defaultEngine());
+        }
+
+        /*! Generates a neighbor TravelingSalesmanSolution from this current TravelingSalesmanSolution.
+        @param neighbor The TravelingSalesmanSolution object which will receive the value.
+        @param prng The random number generator to draw from */
+        template<class URBG>
+        void generateNeighbor(TravelingSalesmanSolution &neighbor, URBG &prng) {
+            if (_neighborhood.orOpt + _neighborhood.twoOpt + _neighborhood.swap + _neighborhood.nearInsertion > 0 ||
+                _solution.size() < 4) {
+                Move move = proposeMove(prng);
+                evaluateMove(move);
+                neighbor = *this;
+                neighbor.commitMove(move);
+                return;
+            }
+            std::uniform_real_distribution<> dis{0.0, 1.0};
+            uint32_t firstswitch = 0;
+            uint32_t numCustomers = _solution.size();
+            neighbor.setF(getF());
+            neighbor.setP(getP());
+            while (0 == firstswitch)
+                firstswitch = static_cast<int>((numCustomers - 1) * dis(prng)) + 1;
+            uint32_t secondswitch = firstswitch;
+            while ((secondswitch == firstswitch) || (secondswitch == firstswitch - 1))
+                secondswitch = static_cast<int>((numCustomers - 1) * dis(prng)) + 1;
+            int holder = _solution[firstswitch];
+            if (firstswitch < secondswitch) {
+                std::copy(_solution.begin(), _solution.begin() + firstswitch,
+                          neighbor._solution.begin());
+                std::copy(_solution.begin() + firstswitch + 1,
+                          _solution.begin() + secondswitch + 1,
+                          neighbor._solution.begin() + firstswitch);
+                neighbor._solution[secondswitch] = holder;
+                neighbor._firstarrival = static_cast<uint32_t>(_arrivaltime[firstswitch - 1]);
+                neighbor._firstpenalty = static_cast<uint32_t>(_penaltysum[firstswitch - 1]);
+                std::copy(_arrivaltime.begin(), _arrivaltime.begin() + firstswitch,
+                          neighbor._arrivaltime.begin());
+                std::copy(_penaltysum.begin(), _penaltysum.begin() + firstswitch,
+                          neighbor._penaltysum.begin());
+            } else {
+                std::copy(_solution.begin(), _solution.begin() + secondswitch + 1,
+                          neighbor._solution.begin());
+                std::copy(_solution.begin() + secondswitch + 1,
+                          _solution.begin() + firstswitch,
+                          neighbor._solution.begin() + secondswitch + 2);
+                neighbor._solution[secondswitch + 1] = holder;
+                neighbor._firstarrival = static_cast<uint32_t>(_arrivaltime[secondswitch]);
+                neighbor._firstpenalty = static_cast<uint32_t>(_penaltysum[secondswitch]);
+                std::copy(_arrivaltime.begin(), _arrivaltime.begin() + secondswitch + 1,
+                          neighbor._arrivaltime.begin());
+                std::copy(_penaltysum.begin(), _penaltysum.begin() + secondswitch + 1,
+                          neighbor._penaltysum.begin());
+            }
+            if (std::max(firstswitch, secondswitch) != numCustomers)
+                std::copy(_solution.begin() + std::max(firstswitch, secondswitch) + 1,
+                          _solution.end(),
+                          neighbor._solution.begin() + std::max(firstswitch, secondswitch) + 1);
+            neighbor._firstswitch = firstswitch;
+            neighbor._secondswitch = secondswitch;
+            neighbor._position.assign(_position.begin(), _position.end());
+            neighbor.reindex(std::min(firstswitch, secondswitch + 1), std::max(firstswitch, secondswitch));
+            neighbor.update();
+        }
+
+        //! The kinds of move a TravelingSalesmanSolution can make.
+        enum class MoveKind : uint8_t {
+            Insertion, //!< Take one customer out and put it back in elsewhere
+            OrOpt,     //!< The same, for a run of two or three customers
+            TwoOpt,    //!< Reverse the run of customers between two positions
+            Swap       //!< Exchange the customers at two positions
+        };
+
+        //! A move which has been proposed but not (necessarily) made.
+        /*! For Insertion and OrOpt, the length customers starting at position
+            from are taken out of the tour and put back in, in order, after the
+            customer at position to; Insertion is exactly what generateNeighbor()
+            does.  For TwoOpt and Swap, from < to are the ends of the run to
+            reverse or the two positions to exchange.  evaluateMove() fills in
+            f and p, the feasible and penalty components the tour would have if
+            the move were made. */
+        struct Move {
+            MoveKind kind{MoveKind::Insertion};
+            uint32_t from{0}, to{0}, length{1};
+            double f{0.0}, p{0.0};
+        };
+
+        //! How often each kind of move is proposed.
+        /*! The weights are relative and need not sum to one.  The default is
+            Insertion alone, as in earlier versions. */
+        struct Neighborhood {
+            double insertion{1.0}, orOpt{0.0}, twoOpt{0.0}, swap{0.0};
+            //! Insertions whose insertion point comes from the moved customer's
+            //! candidate list (see TravelingSalesmanWorld::computeCandidates())
+            double nearInsertion{0.0};
+        };
+
+        /*! Sets how often each kind of move is proposed.  Copies of this solution,
+        including those an Annealer makes, inherit the mix.
+        @param mix The relative weight of each kind of move */
+        void setNeighborhood(const Neighborhood &mix) {
+            if (mix.insertion < 0 || mix.orOpt < 0 || mix.twoOpt < 0 || mix.swap < 0 || mix.nearInsertion < 0 ||
+                mix.insertion + mix.orOpt + mix.twoOpt + mix.swap + mix.nearInsertion <= 0)
+                throw std::invalid_argument("neighborhood weights must be non-negative and not all zero");
+            _neighborhood = mix;
+        }
+
+        /*! Returns how often each kind of move is proposed.
+        @return The relative weight of each kind of move */
+        [[nodiscard]] const Neighborhood &neighborhood() const { return _neighborhood; }
+
+        /*! Picks a random move from this TravelingSalesmanSolution, drawing random
+        numbers from this thread's default generator.
+        @return The move, not yet evaluated */
+        [[nodiscard]] Move proposeMove() const { return proposeMove(defaultEngine()); }
+
+        /*! Picks a random move from this TravelingSalesmanSolution, of a kind
+        chosen according to the neighborhood mix.  With the default mix it makes
+        the same draws as generateNeighbor(), so a given generator proposes the
+        same moves either way.  Kinds of move the tour is too short for are
+        replaced by an Insertion.  A tour of one or two customers has no
+        Insertion to draw, and gets the only TwoOpt there is: one that leaves
+        a lone customer where it is, or flips a pair.
+        @param prng The random number generator to draw from
+        @return The move, not yet evaluated */
+        template<class URBG>
+        [[nodiscard]] Move proposeMove(URBG &prng) const {
+            std::uniform_real_distribution<> dis{0.0, 1.0};
+            uint32_t numCustomers = _solution.size();
+            Move move;
+            if (numCustomers < 4) {
+                move.kind = MoveKind::TwoOpt;
+                move.from = 1;
+                move.to = numCustomers - 1;
+                return move;
+            }
+            bool nearby = false;
+            const double others = _neighborhood.orOpt + _neighborhood.twoOpt + _neighborhood.swap +
+                                  _neighborhood.nearInsertion;
+            if (others > 0) {
+                double pick = (_neighborhood.insertion + others) * dis(prng);
+                if ((pick -= _neighborhood.insertion) < 0)
+                    move.kind = MoveKind::Insertion;
+                else if ((pick -= _neighborhood.nearInsertion) < 0)
+                    nearby = true;
+                else if ((pick -= _neighborhood.orOpt) < 0)
+                    move.kind = MoveKind::OrOpt;
+                else if ((pick -= _neighborhood.twoOpt) < 0 || _neighborhood.swap == 0)
+                    move.kind = MoveKind::TwoOpt;
+                else
+                    move.kind = MoveKind::Swap;
+            }
+            if (move.kind == MoveKind::OrOpt) {
+                move.length = dis(prng) < 0.5 ? 2 : 3;
+                if (numCustomers < move.length + 2)
+                    move.kind = MoveKind::Insertion;
+            }
+            switch (move.kind) {
+                case MoveKind::OrOpt:
+                    move.from = static_cast<int>((numCustomers - move.length) * dis(prng)) + 1;
+                    do
+                        move.to = static_cast<int>(numCustomers * dis(prng));
+                    while (move.to + 1 >= move.from && move.to < move.from + move.length);
+                    break;
+                case MoveKind::TwoOpt:
+                case MoveKind::Swap:
+                    move.from = static_cast<int>((numCustomers - 1) * dis(prng)) + 1;
+                    move.to = move.from;
+                    while (move.to == move.from)
+                        move.to = static_cast<int>((numCustomers - 1) * dis(prng)) + 1;
+                    if (move.to < move.from)
+                        std::swap(move.from, move.to);
+                    break;
+                case MoveKind::Insertion:
+                    move.length = 1;
+                    while (0 == move.from)
+                        move.from = static_cast<int>((numCustomers - 1) * dis(prng)) + 1;
+                    if (nearby && nearbyInsertionPoint(move, prng))
+                        break;
+                    move.to = move.from;
+                    while ((move.to == move.from) || (move.to == move.from - 1))
+                        move.to = static_cast<int>((numCustomers - 1) * dis(prng)) + 1;
+                    break;
+            }
+            return move;
+        }
+
+        /*! Works out what the tour would cost after a move, without making it.
+        For an Insertion the change in F involves only the six edges on either
+        side of the moved customer; other moves total the edges in the part of
+        the tour they disturb, which the penalty walk has to visit anyway.  The
+        penalty is found by walking the new schedule from the first position the
+        move disturbs.  Once past the disturbed part of the tour, the walk stops
+        as soon as the rest of the penalty is known not to change: when we would
+        arrive later than now but by no more than the forward slack, when we
+        would arrive earlier with nothing left to be late for, or when we would
+        leave a customer at the same time as we do now.
+        @param move The move to evaluate; its f and p are filled in */
+        void evaluateMove(Move &move) const {
+            const uint32_t numCustomers = _solution.size();
+            const auto &travTime = _w->travelTimes();
+            const WorldWindows<WorldType> windows(*_w);
+            const auto [start, end] = disturbedBy(move);
+
+            auto cost = static_cast<TimeType>(getF());
+            if (move.kind == MoveKind::Insertion) {
+                const int moved = _solution[move.from];
+                const int before = _solution[move.from - 1];
+                const int after = _solution[(move.from + 1) % numCustomers];
+                const int left = _solution[move.to];
+                const int right = _solution[(move.to + 1) % numCustomers];
+                cost -= (travTime[before][moved] + travTime[moved][after] + travTime[left][right]);
+                cost += (travTime[before][after] + travTime[left][moved] + travTime[moved][right]);
+            } else {
+                int oldPrevious = _solution[start - 1];
+                int newPrevious = oldPrevious;
+                for (uint32_t i = start; i <= end; ++i) {
+                    const int customer = customerAfterMove(move, i);
+                    cost += travTime[newPrevious][customer];
+                    cost -= travTime[oldPrevious][_solution[i]];
+                    oldPrevious = _solution[i];
+                    newPrevious = customer;
+                }
+                const int next = _solution[(end + 1) % numCustomers];
+                cost += travTime[newPrevious][next];
+                cost -= travTime[oldPrevious][next];
+            }
+            move.f = cost;
+
+            TimeType arrival = _arrivaltime[start - 1];
+            TimeType penalty = _penaltysum[start - 1];
+            int previous = _solution[start - 1];
+            for (uint32_t i = start; i < numCustomers; ++i) {
+                const int customer = customerAfterMove(move, i);
+                arrival = std::max(arrival, windows.ready(previous)) + travTime[previous][customer];
+                if (i > end) {
+                    const TimeType shift = arrival - _arrivaltime[i];
+                    if ((shift > 0 && shift <= _slack[i]) ||
+                        (shift < 0 && _penaltysum[numCustomers - 1] == _penaltysum[i - 1])) {
+                        penalty += _penaltysum[numCustomers - 1] - _penaltysum[i - 1];
+                        break;
+                    }
+                }
+                if (arrival > windows.due(customer))
+                    penalty += arrival - windows.due(customer);
+                if (i > end && std::max(arrival, windows.ready(customer)) ==
+                               std::max(_arrivaltime[i], windows.ready(customer))) {
+                    penalty += _penaltysum[numCustomers - 1] - _penaltysum[i];
+                    break;
+                }
+                previous = customer;
+            }
+            move.p = penalty;
+        }
+
+        /*! Makes a move, updating the tour and its schedule from the first
+        position the move disturbs.
+        @param move A move evaluated against this solution as it stands */
+        void commitMove(const Move &move) {
+            auto tour = _solution.begin();
+            switch (move.kind) {
+                case MoveKind::Insertion:
+                case MoveKind::OrOpt:
+                    if (move.from < move.to)
+                        std::rotate(tour + move.from, tour + move.from + move.length, tour + move.to + 1);
+                    else
+                        std::rotate(tour + move.to + 1, tour + move.from, tour + move.from + move.length);
+                    break;
+                case MoveKind::TwoOpt:
+                    std::reverse(tour + move.from, tour + move.to + 1);
+                    break;
+                case MoveKind::Swap:
+                    std::iter_swap(tour + move.from, tour + move.to);
+                    break;
+            }
+            _firstswitch = move.from;
+            _secondswitch = move.to;
+            const auto [start, end] = disturbedBy(move);
+            reindex(start, end);
+            rescheduleFrom(start, end);
+            setF(move.f);
+            setP(_penaltysum[_solution.size() - 1]);
+        }
+
+        /*! Update schedules, member data, etc., based on current state. */
+        void update() {
+            auto cost = static_cast<TimeType>(getF());
+            int firstswitch = _firstswitch;
+            int secondswitch = _secondswitch;
+            int numCustomers = _solution.size();
+            const auto &tour = _solution;
+            const auto &travTime = _w->travelTimes();
+            if (firstswitch <= secondswitch) {
+                if (secondswitch != (numCustomers - 1)) {
+                    cost -= (travTime[tour[firstswitch - 1]][tour[secondswitch]] + travTime[tour[
+                                 secondswitch]][tour[
+                                 firstswitch]] + travTime[tour[secondswitch - 1]][tour[secondswitch + 1]]);
+                    cost += (travTime[tour[firstswitch - 1]][tour[firstswitch]] + travTime[tour[
+                                 secondswitch - 1]][tour[
+                                 secondswitch]] + travTime[tour[secondswitch]][tour[secondswitch + 1]]);
+                } else {
+                    cost -= (travTime[tour[firstswitch - 1]][tour[secondswitch]] + travTime[tour[
+                                 secondswitch]][tour[
+                                 firstswitch]] + travTime[tour[secondswitch - 1]][tour[0]]);
+                    cost += (travTime[tour[firstswitch - 1]][tour[firstswitch]] + travTime[tour[
+                                 secondswitch - 1]][tour[
+                                 secondswitch]] + travTime[tour[secondswitch]][tour[0]]);
+                }
+                timingUpdate();
+            } else {
+                if (firstswitch != (numCustomers - 1)) {
+                    cost -= (travTime[tour[secondswitch]][tour[secondswitch + 2]] + travTime[tour[
+                                 firstswitch]][tour[
+                                 secondswitch + 1]] + travTime[tour[secondswitch + 1]][tour[
+                                 firstswitch + 1]]);
+                    cost += (travTime[tour[firstswitch]][tour[firstswitch + 1]] + travTime[tour[
+                                 secondswitch]][tour[
+                                 secondswitch + 1]] + travTime[tour[secondswitch + 1]][tour[
+                                 secondswitch + 2]]);
+                } else {
+                    cost -= (travTime[tour[secondswitch]][tour[secondswitch + 2]] + travTime[tour[
+                                 firstswitch]][tour[
+                                 secondswitch + 1]] + travTime[tour[secondswitch + 1]][tour[0]]);
+                    cost += (travTime[tour[firstswitch]][tour[0]] + travTime[tour[secondswitch]][tour[
+                                 secondswitch + 1]] +
+                             travTime[tour[secondswitch + 1]][tour[secondswitch + 2]]);
+                }
+                timingUpdate();
+            }
+            setF(cost);
+            setP(_penaltysum[numCustomers - 1]);
+        }
+
+        /*! Randomize this TravelingSalesmanSolution, drawing random numbers from
+        this thread's default generator. */
+        void randomize() { randomize(defaultEngine()); }
+
+        /*! Randomize this TravelingSalesmanSolution.
+        @param prng The random number generator to draw from */
+        template<class URBG>
+        void randomize(URBG &prng) {
+            for (uint32_t i = 0; i < _solution.size(); i += 1)
+                _solution[i] = static_cast<int>(i);
+            auto iter = _solution.begin();
+            ++iter;
+            std::shuffle(iter, _solution.end(), prng);
+            reindex(0, _solution.size() - 1);
+        }
+
+        /*! Copy constructor.
+        @param route The route to copy from. */
+        TravelingSalesmanSolution(const TravelingSalesmanSolution &route)
+            : _w(route._w)
+              , _solution(route._solution)
+              , _f(route._f)
+              , _p(route._p)
+              , _identifier(route._identifier)
+              , _arrivaltime(route._arrivaltime)
+              , _penaltysum(route._penaltysum)
+              , _time(route._time)
+              , _cost(route._cost)
+              , _timeWait(route._timeWait)
+              , _firstswitch(route._firstswitch)
+              , _secondswitch(route._secondswitch)
+              , _firstarrival(route._firstarrival)
+              , _firstpenalty(route._firstpenalty)
+              , _position(route._position)
+              , _slack(route._slack)
+              , _neighborhood(route._neighborhood) {
+        }
+
+        /*! Copy assignment.  Annealers do this a lot, so the storage we already
+        have is reused and the world pointer is left alone (sparing an atomic
+        reference count update) when both solutions already share it.
+        @param route The route to copy from.
+        @return This route */
+        TravelingSalesmanSolution &operator=(const TravelingSalesmanSolution &route) {
+            if (this == &route)
+                return *this;
+            if (_w != route._w)
+                _w = route._w;
+            _solution.assign(route._solution.begin(), route._solution.end());
+            _arrivaltime.assign(route._arrivaltime.begin(), route._arrivaltime.end());
+            _penaltysum.assign(route._penaltysum.begin(), route._penaltysum.end());
+            if (_identifier != route._identifier)
+                _identifier = route._identifier;
+            _f = route._f;
+            _p = route._p;
+            _time = route._time;
+            _cost = route._cost;
+            _timeWait = route._timeWait;
+            _firstswitch = route._firstswitch;
+            _secondswitch = route._secondswitch;
+            _firstarrival = route._firstarrival;
+            _firstpenalty = route._firstpenalty;
+            _position.assign(route._position.begin(), route._position.end());
+            _slack.assign(route._slack.begin(), route._slack.end());
+            _neighborhood = route._neighborhood;
+            return *this;
+        }
+
+        /*! Dump our current path to an output stream.
+        @param os The output stream to dump our path to
+        @return The output stream after we've dumped in it */
+        std::ostream &dump(std::ostream &os) const {
+            std::ostream_iterator<int> oiter(os, " ");
+            std::ranges::copy(_solution, oiter);
+            return os;
+        }
+
+        /*! Computes the feasible and penalty portions of this TravelingSalesmanSolution. */
+        void compute() {
+            TimeType addEnergy = 0;
+            TimeType energy = 0;
+            TimeType minutesMissed = 0;
+            TimeType routeTime = 0;
+            TimeType waitTime = 0;
+
+            const auto &travTime = _w->travelTimes();
+            const WorldWindows<WorldType> windows(*_w);
+
+            _penaltysum[0] = 0;
+            _arrivaltime[0] = 0;
+
+            for (uint32_t i = 0; i < _solution.size() - 1; ++i) {
+                energy += travTime[_solution[i]][_solution[i + 1]];
+                routeTime += travTime[_solution[i]][_solution[i + 1]];
+                _arrivaltime[i + 1] = energy;
+                if (energy < windows.ready(_solution[i + 1])) {
+                    addEnergy = windows.ready(_solution[i + 1]) - energy;
+                    waitTime += addEnergy;
+                    energy += addEnergy;
+                }
+                if (energy > windows.due(_solution[i + 1]))
+                    minutesMissed += energy - windows.due(_solution[i + 1]);
+                _penaltysum[i + 1] = minutesMissed;
+            }
+            //        energy += travTime[_solution[_solution.size() - 1]][_solution[0]];
+            routeTime += travTime[_solution[_solution.size() - 1]][_solution[0]];
+            setF(routeTime);
+            _time = routeTime;
+            setP(minutesMissed);
+            _timeWait = waitTime;
+            slackFrom(_solution.size() - 1, 0);
+        }
+
+    protected:
+        /*! Update the travel schedule. */
+        void timingUpdate() {
+            int start;
+            if (_firstswitch < _secondswitch)
+                start = _firstswitch;
+            else
+                start = _secondswitch + 1;
+
+            _arrivaltime[start - 1] = _firstarrival;
+            _penaltysum[start - 1] = _firstpenalty;
+            scheduleFrom(start);
+        }
+
+        /*! Recomputes arrival times and running penalties from a given position
+        to the end of the tour, starting from those at the position before it.
+        @param start The first position to recompute */
+        void scheduleFrom(const int start) {
+            int numCustomers = _solution.size();
+            const auto &travTime = _w->travelTimes();
+            const WorldWindows<WorldType> windows(*_w);
+            const auto &tour = _solution;
+
+            for (int i = start; i <= numCustomers - 1; i++) {
+                if (_arrivaltime[i - 1] >= windows.ready(tour[i - 1]))
+                    _arrivaltime[i] = _arrivaltime[i - 1] + travTime[tour[i - 1]][tour[i]];
+                else
+                    _arrivaltime[i] = windows.ready(tour[i - 1]) + travTime[tour[i - 1]][tour[i]];
+                if (_arrivaltime[i] > windows.due(tour[i]))
+                    _penaltysum[i] = _penaltysum[i - 1] + (_arrivaltime[i] - windows.due(tour[i]));
+                else
+                    _penaltysum[i] = _penaltysum[i - 1];
+            }
+            slackFrom(numCustomers - 1, 0);
+        }
+
+        /*! As scheduleFrom(), for a tour which has changed only between two
+        positions and whose schedule is otherwise up to date.  Past the change,
+        we stop as soon as we arrive somewhere at the same time as before:
+        arrival times from there on are unchanged, and running penalties only
+        need shifting by however much the penalty before that point changed.
+        @param start The first position which changed
+        @param end The last position which changed */
+        void rescheduleFrom(const uint32_t start, const uint32_t end) {
+            const uint32_t numCustomers = _solution.size();
+            const auto &travTime = _w->travelTimes();
+            const WorldWindows<WorldType> windows(*_w);
+            const auto &tour = _solution;
+
+            TimeType oldPenalty = _penaltysum[start - 1];
+            uint32_t i = start;
+            for (; i < numCustomers; i++) {
+                const TimeType arrival = std::max(_arrivaltime[i - 1], windows.ready(tour[i - 1])) +
+                                         travTime[tour[i - 1]][tour[i]];
+                if (i > end && arrival == _arrivaltime[i])
+                    break;
+                const TimeType penalty = _penaltysum[i - 1] + std::max<TimeType>(0, arrival - windows.due(tour[i]));
+                _arrivaltime[i] = arrival;
+                oldPenalty = std::exchange(_penaltysum[i], penalty);
+            }
+            if (const TimeType change = _penaltysum[i - 1] - oldPenalty; change != 0)
+                for (uint32_t j = i; j < numCustomers; j++)
+                    _penaltysum[j] += change;
+            slackFrom(i - 1, start);
+        }
+
+        /*! Recomputes forward slack, working back from one position.  The
+        forward slack at a position is how much later we could arrive there
+        without adding any penalty from there to the end of the tour: the
+        least of the margin before its own deadline and, for everyone after
+        it, their margin plus whatever waiting we do in between.  Since it
+        only depends on what comes after, we can stop once we're before start
+        and find a value that hasn't changed.
+        @param last The last position to recompute
+        @param start The first position whose schedule changed */
+        void slackFrom(const uint32_t last, const uint32_t start) {
+            const WorldWindows<WorldType> windows(*_w);
+            const auto &tour = _solution;
+            const uint32_t numCustomers = _solution.size();
+
+            for (uint32_t i = last; i >= 1; i--) {
+                const TimeType wait = std::max<TimeType>(0, windows.ready(tour[i]) - _arrivaltime[i]);
+                TimeType slack = windows.due(tour[i]) - _arrivaltime[i];
+                if (i + 1 < numCustomers)
+                    slack = std::min(slack, wait + _slack[i + 1]);
+                if (i < start && slack == _slack[i])
+                    break;
+                _slack[i] = slack;
+            }
+        }
+
+        /*! Picks where to insert a customer from its candidate list, starting
+        at a random entry and taking the first that doesn't leave the tour as
+        it is.
+        @param move An Insertion whose from is set; its to is filled in
+        @param prng The random number generator to draw from
+        @return False if the world has no usable candidates for the customer */
+        template<class URBG>
+        bool nearbyInsertionPoint(Move &move, URBG &prng) const {
+            if constexpr (requires { _w->candidates(); _w->candidateCount(0); }) {
+                const int customer = _solution[move.from];
+                const uint32_t count = _w->candidateCount(customer);
+                if (0 == count)
+                    return false;
+                const auto candidates = _w->candidates()[customer];
+                std::uniform_int_distribution<uint32_t> pick{0, count - 1};
+                const uint32_t first = pick(prng);
+                for (uint32_t i = 0; i < count; i += 1) {
+                    const uint32_t to = _position[candidates[(first + i) % count]];
+                    if (to != move.from && to + 1 != move.from) {
+                        move.to = to;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        /*! Records where each customer in part of the tour now sits.
+        @param first The first position to record
+        @param last The last position to record */
+        void reindex(const uint32_t first, const uint32_t last) {
+            for (uint32_t i = first; i <= last; i += 1)
+                _position[_solution[i]] = i;
+        }
+
+        /*! Who would be at a given position in the tour after a move.
+        @param move The move
+        @param i A position in the tour
+        @return The customer at position i once the move is made */
+        [[nodiscard]] int customerAfterMove(const Move &move, const uint32_t i) const {
+            switch (move.kind) {
+                case MoveKind::TwoOpt:
+                    if (i < move.from || i > move.to)
+                        return _solution[i];
+                    return _solution[move.from + move.to - i];
+                case MoveKind::Swap:
+                    if (i == move.from)
+                        return _solution[move.to];
+                    return i == move.to ? _solution[move.from] : _solution[i];
+                default:
+                    break;
+            }
+            if (move.from < move.to) {
+                if (i < move.from || i > move.to)
+                    return _solution[i];
+                if (i + move.length > move.to)
+                    return _solution[move.from + move.length + i - move.to - 1];
+                return _solution[i + move.length];
+            }
+            if (i <= move.to || i >= move.from + move.length)
+                return _solution[i];
+            if (i <= move.to + move.length)
+                return _solution[move.from + i - move.to - 1];
+            return _solution[i - move.length];
+        }
+
+        /*! The part of the tour a move changes.
+        @param move The move
+        @return The first and last positions whose customers the move changes */
+        [[nodiscard]] static std::pair<uint32_t, uint32_t> disturbedBy(const Move &move) {
+            if ((move.kind == MoveKind::Insertion || move.kind == MoveKind::OrOpt) && move.from > move.to)
+                return {move.to + 1, move.from + move.length - 1};
+            return {move.from, move.to};
+        }
+
+        std::shared_ptr<WorldType> _w;
+        Storage<int> _solution;
+        double _f, _p;
+        std::string _identifier;
+        Storage<TimeType> _arrivaltime;
+        Storage<TimeType> _penaltysum;
+        double _time, _cost, _timeWait;
+        uint32_t _firstswitch, _secondswitch, _firstarrival, _firstpenalty;
+        Storage<uint32_t> _position;
+        Storage<TimeType> _slack;
+        Neighborhood _neighborhood;
+
+        /*! The generator used when the caller doesn't supply one.  Each thread
+            gets its own, so concurrent solutions never share state; pass your
+            own generator instead if you need reproducible results. */
+        static std::mt19937_64 &defaultEngine() {
+            thread_local std::mt19937_64 prng{randomSeed()};
+            return prng;
+        }
+    };
+
+    /*! An operator<< overloaded for TravelingSalesmanSolution.
+
+        @param os An output stream to write to
+        @param sol A TravelingSalesmanSolution to write
+        @return An output stream after we've written to it
+    */
+    template<class WorldType, uint32_t Size>
+    std::ostream &operator<<(std::ostream &os, const TravelingSalesmanSolution<WorldType, Size> &sol) {
+        return sol.dump(os);
+    }
+
+    /*! A more human-readable version of a fully qualified typename. */
+    typedef TravelingSalesmanSolution<TravelingSalesmanWorld> TravelingSalesman;
+}
+
+
+#endif